@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// settings shared by every benchmark case, parsed from the command line.
+struct BenchmarkSettings
+{
+    double secondsPerCase = 2.0;    // length of audio rendered per case
+    double warmUpSeconds  = 0.1;    // rendered before timing starts, not reported
+    bool quick            = false;  // reduced sweep for smoke runs
+    juce::String filter;            // only run cases whose name contains this
+
+    bool shouldRun (const juce::String& caseName) const
+    {
+        return filter.isEmpty() || caseName.contains (filter);
+    }
+};
+
+//==============================================================================
+// times a block callback over a fixed length of audio and summarises the per-block cost.
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner (const BenchmarkSettings& s) : settings (s) {}
+
+    // processBlock() is called once per block and must process blockSize samples.
+    template <typename ProcessBlock>
+    juce::DynamicObject::Ptr run (const juce::String& caseName, int blockSize, double sampleRate,
+                                  ProcessBlock&& processBlock)
+    {
+        auto numWarmUpBlocks = juce::jmax (1, (int) (settings.warmUpSeconds * sampleRate / blockSize));
+        auto numBlocks       = juce::jmax (8, (int) (settings.secondsPerCase * sampleRate / blockSize));
+
+        for (int i = 0; i < numWarmUpBlocks; ++i)
+            processBlock();
+
+        blockSeconds.resize ((size_t) numBlocks);
+
+        for (auto& t : blockSeconds)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            processBlock();
+            t = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+        }
+
+        auto result = summarise (blockSize, sampleRate);
+        result->setProperty ("name", caseName);
+        results.add (juce::var (result.get()));
+
+        std::cerr << caseName << " block=" << blockSize << " sr=" << sampleRate
+                  << " rtf=" << (double) result->getProperty ("realtimeFactor") << std::endl;
+        return result;
+    }
+
+    juce::String toJSON() const
+    {
+        auto root = new juce::DynamicObject();
+        root->setProperty ("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty ("numCpus", juce::SystemStats::getNumCpus());
+        root->setProperty ("os", juce::SystemStats::getOperatingSystemName());
+        root->setProperty ("secondsPerCase", settings.secondsPerCase);
+        root->setProperty ("results", results);
+        return juce::JSON::toString (juce::var (root));
+    }
+
+private:
+    juce::DynamicObject::Ptr summarise (int blockSize, double sampleRate)
+    {
+        auto numBlocks    = blockSeconds.size();
+        auto totalSeconds = std::accumulate (blockSeconds.begin(), blockSeconds.end(), 0.0);
+        auto numSamples   = (double) numBlocks * blockSize;
+
+        std::sort (blockSeconds.begin(), blockSeconds.end());
+        auto p99 = blockSeconds[juce::jmin (numBlocks - 1, (size_t) std::ceil (0.99 * (double) numBlocks) - 1)];
+
+        juce::DynamicObject::Ptr result (new juce::DynamicObject());
+        result->setProperty ("blockSize", blockSize);
+        result->setProperty ("sampleRate", sampleRate);
+        result->setProperty ("numBlocks", (int) numBlocks);
+        result->setProperty ("nsPerSample", totalSeconds * 1.0e9 / numSamples);
+        result->setProperty ("samplesPerSecond", numSamples / totalSeconds);
+        result->setProperty ("realtimeFactor", (numSamples / sampleRate) / totalSeconds);
+        result->setProperty ("meanBlockMicroseconds", totalSeconds * 1.0e6 / (double) numBlocks);
+        result->setProperty ("p99BlockMicroseconds", p99 * 1.0e6);
+        result->setProperty ("blockDeadlineMicroseconds", blockSize * 1.0e6 / sampleRate);
+        return result;
+    }
+
+    const BenchmarkSettings& settings;
+    std::vector<double> blockSeconds;
+    juce::Array<juce::var> results;
+};
@@ -0,0 +1,1316 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+    Micro-benchmarks for FMSynthesizer::renderVoices and Effect::process.
+    Results are printed as JSON so that runs can be compared across releases.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/Synth.h"
+#include "Benchmark.h"
+
+//==============================================================================
+static std::vector<int> getBlockSizes (const BenchmarkSettings& s)
+{
+    if (s.quick) return { 64, 512 };
+    return { 16, 64, 256, 1024, 4096 };
+}
+
+static std::vector<double> getSampleRates (const BenchmarkSettings& s)
+{
+    if (s.quick) return { 48000.0 };
+    return { 44100.0, 48000.0, 96000.0 };
+}
+
+static std::vector<int> getVoiceCounts (const BenchmarkSettings& s)
+{
+    if (s.quick) return { 4, 64 };
+    return { 4, 8, 16, 32, 64, 128, 256 };
+}
+
+// start a held note on every voice; MIDI channels are used to get more than 128 distinct notes.
+static void startAllVoices (FMSynthesizer& synth, int numVoices)
+{
+    for (int i = 0; i < numVoices; ++i)
+        synth.noteOn (1 + i / 128, i % 128, 0.8f);
+}
+
+// an FM patch with the modulator switched on, so that both oscillators of every voice do real work.
+static FMParameters getBenchmarkFMParameters()
+{
+    auto p = getFMPreset ("Default");
+    p.modulatorAmplitude = 2.0f;
+    p.modulatorFreqRatio = 1.5f;
+    return p;
+}
+
+// the ways FMSynthesizer can render its voices, with the benchmark case name of each.
+enum class VoiceEngine { block, perSample, voiceBank };
+
+static const char* getCaseName (VoiceEngine engine)
+{
+    switch (engine)
+    {
+        case VoiceEngine::perSample:    return "renderVoices/perSample";
+        case VoiceEngine::voiceBank:    return "renderVoices/voiceBank";
+        case VoiceEngine::block:
+        default:                        return "renderVoices";
+    }
+}
+
+static void prepareSynth (FMSynthesizer& synth, int numVoices, double sampleRate, VoiceEngine engine)
+{
+    if (engine == VoiceEngine::voiceBank)
+    {
+        synth.useVoiceBank (numVoices);
+    }
+    else
+    {
+        synth.setPolyphony (numVoices);
+    }
+
+    synth.addSound (new SineWaveSound());
+    synth.setCurrentPlaybackSampleRate (sampleRate);
+    synth.setSampleRate();
+    synth.setFMParameters (getBenchmarkFMParameters());
+    synth.setBlockRendering (engine != VoiceEngine::perSample);
+    startAllVoices (synth, numVoices);
+}
+
+// largest difference between the block and the per-sample voice renderer over a second of audio.
+static float measureBlockRenderingError (int numVoices, int blockSize, double sampleRate)
+{
+    FMSynthesizer blockSynth, sampleSynth;
+    prepareSynth (blockSynth, numVoices, sampleRate, VoiceEngine::block);
+    prepareSynth (sampleSynth, numVoices, sampleRate, VoiceEngine::perSample);
+
+    juce::AudioBuffer<float> blockBuffer (1, blockSize), sampleBuffer (1, blockSize);
+    auto maxError = 0.0f;
+
+    for (int position = 0; position < (int) sampleRate; position += blockSize)
+    {
+        blockBuffer.clear();
+        sampleBuffer.clear();
+        blockSynth.renderVoices (blockBuffer, 0, blockSize);
+        sampleSynth.renderVoices (sampleBuffer, 0, blockSize);
+
+        for (int i = 0; i < blockSize; ++i)
+            maxError = juce::jmax (maxError, std::abs (blockBuffer.getSample (0, i) - sampleBuffer.getSample (0, i)));
+    }
+
+    return maxError;
+}
+
+//==============================================================================
+static void benchmarkRenderVoices (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    for (auto engine : { VoiceEngine::block, VoiceEngine::perSample, VoiceEngine::voiceBank })
+    {
+        auto caseName = juce::String (getCaseName (engine));
+
+        if (! settings.shouldRun (caseName))
+            continue;
+
+        for (auto sampleRate : getSampleRates (settings))
+        {
+            for (auto numVoices : getVoiceCounts (settings))
+            {
+                for (auto blockSize : getBlockSizes (settings))
+                {
+                    FMSynthesizer synth;
+                    prepareSynth (synth, numVoices, sampleRate, engine);
+
+                    juce::AudioBuffer<float> buffer (2, blockSize);
+
+                    auto result = runner.run (caseName, blockSize, sampleRate, [&]
+                    {
+                        buffer.clear();
+                        synth.renderVoices (buffer, 0, blockSize);
+                    });
+
+                    auto nsPerSample = (double) result->getProperty ("nsPerSample");
+                    result->setProperty ("voices", numVoices);
+                    result->setProperty ("nsPerVoiceSample", nsPerSample / numVoices);
+                    result->setProperty ("maxVoicesPerCore", numVoices * (double) result->getProperty ("realtimeFactor"));
+
+                    if (engine == VoiceEngine::block)
+                        result->setProperty ("maxErrorVsPerSample", measureBlockRenderingError (numVoices, blockSize, sampleRate));
+                }
+            }
+        }
+    }
+}
+
+// a pool far larger than the number of sounding notes costs the same as a pool of exactly that size.
+static void benchmarkVoicePool (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const juce::String caseName ("renderVoices/pool512");
+    const int poolSize = 512, blockSize = 512;
+    const double sampleRate = 48000.0;
+
+    if (! settings.shouldRun (caseName))
+        return;
+
+    for (auto numVoices : getVoiceCounts (settings))
+    {
+        FMSynthesizer synth;
+        synth.setPolyphony (poolSize);
+        synth.addSound (new SineWaveSound());
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+        synth.setFMParameters (getBenchmarkFMParameters());
+        startAllVoices (synth, numVoices);
+
+        juce::AudioBuffer<float> buffer (2, blockSize);
+
+        auto result = runner.run (caseName, blockSize, sampleRate, [&]
+        {
+            buffer.clear();
+            synth.renderVoices (buffer, 0, blockSize);
+        });
+
+        result->setProperty ("voices", numVoices);
+        result->setProperty ("poolSize", poolSize);
+        result->setProperty ("nsPerVoiceSample", (double) result->getProperty ("nsPerSample") / numVoices);
+    }
+}
+
+// voices panned by key into stereo group buses; should cost the same as unpanned *renderVoices*.
+static void benchmarkPanning (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const juce::String caseName ("renderVoices/panned");
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+
+    if (! settings.shouldRun (caseName))
+        return;
+
+    for (auto numVoices : getVoiceCounts (settings))
+    {
+        FMSynthesizer synth;
+        synth.setPolyphony (numVoices);
+        synth.setStereoSpread (1.0f);
+        synth.addSound (new SineWaveSound());
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+        synth.setFMParameters (getBenchmarkFMParameters());
+        startAllVoices (synth, numVoices);
+
+        juce::AudioBuffer<float> buffer (2, blockSize);
+
+        auto result = runner.run (caseName, blockSize, sampleRate, [&]
+        {
+            buffer.clear();
+            synth.renderVoices (buffer, 0, blockSize);
+        });
+
+        result->setProperty ("voices", numVoices);
+        result->setProperty ("nsPerVoiceSample", (double) result->getProperty ("nsPerSample") / numVoices);
+    }
+}
+
+// scaling curves of FMVoice rendering over render threads, with the speed-up over one thread.
+static void benchmarkRenderThreads (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const juce::String caseName ("renderVoices/threads");
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+
+    if (! settings.shouldRun (caseName))
+        return;
+
+    auto maxThreads = juce::jmax (2, juce::SystemStats::getNumCpus());
+    auto voiceCounts = settings.quick ? std::vector<int> { 256 } : std::vector<int> { 32, 128, 512 };
+
+    for (auto numVoices : voiceCounts)
+    {
+        auto singleThreadNs = 0.0;
+
+        for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+        {
+            FMSynthesizer synth;
+            prepareSynth (synth, numVoices, sampleRate, VoiceEngine::block);
+            synth.setNumRenderThreads (numThreads);
+
+            juce::AudioBuffer<float> buffer (2, blockSize);
+
+            auto result = runner.run (caseName, blockSize, sampleRate, [&]
+            {
+                buffer.clear();
+                synth.renderVoices (buffer, 0, blockSize);
+            });
+
+            auto nsPerSample = (double) result->getProperty ("nsPerSample");
+
+            if (numThreads == 1)
+                singleThreadNs = nsPerSample;
+
+            result->setProperty ("voices", numVoices);
+            result->setProperty ("threads", numThreads);
+            result->setProperty ("speedUp", singleThreadNs / nsPerSample);
+        }
+    }
+}
+
+// random input of numChannels channels, copied into the buffer before each block so that
+// the cases below time the effect and not the random numbers.
+static juce::AudioBuffer<float> makeNoise (int numChannels, int numSamples)
+{
+    juce::AudioBuffer<float> noise (numChannels, numSamples);
+    juce::Random random (1);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            noise.setSample (ch, i, random.nextFloat() * 0.5f - 0.25f);
+
+    return noise;
+}
+
+// an effect of the named type with its default parameters.
+static void prepareEffect (Effect<float>& fx, const char* fxType, double sampleRate, int blockSize)
+{
+    auto fxParameters = getFXPreset (fxType);
+
+    fx.prepare ({ sampleRate, (juce::uint32) blockSize, 2 });
+    fx.setSampleRate ((float) sampleRate);
+    fx.setFXType (fxType);
+    fx.setFeedback (fxParameters.feedback);
+    fx.setDelayTimes (fxParameters.delayTime);
+    fx.setWetDry (fxParameters.wetDry);
+    fx.setLFORate (fxParameters.LFORate);
+    fx.setLFODepth (fxParameters.LFODepth);
+}
+
+// each effect type with fixed parameters, and /automated with every parameter changed before
+// each block, which is ramped across the block and should cost little more. Both time the same
+// pre-generated input; /automated reports its cost relative to the fixed case of the same
+// rate and block size when that case was run.
+static void benchmarkEffects (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    for (auto fxType : { "Delay", "Chorus", "Flanger" })
+    {
+        std::vector<double> fixedNsPerSample;
+
+        for (auto automated : { false, true })
+        {
+            auto caseName = juce::String ("Effect::process/") + fxType + (automated ? "/automated" : "");
+
+            if (! settings.shouldRun (caseName))
+                continue;
+
+            size_t caseIndex = 0;
+
+            for (auto sampleRate : getSampleRates (settings))
+            {
+                for (auto blockSize : getBlockSizes (settings))
+                {
+                    Effect<float> fx;
+                    prepareEffect (fx, fxType, sampleRate, blockSize);
+
+                    auto input = makeNoise (2, blockSize);
+                    juce::AudioBuffer<float> buffer (2, blockSize);
+                    int blockCount = 0;
+
+                    auto result = runner.run (caseName, blockSize, sampleRate, [&]
+                    {
+                        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                            buffer.copyFrom (ch, 0, input, ch, 0, blockSize);
+
+                        if (automated)
+                        {
+                            auto x = (float) (++blockCount % 100) / 100.0f;
+                            fx.setDelayTimes (0.2f + 0.1f * x);
+                            fx.setFeedback (0.3f + 0.2f * x);
+                            fx.setWetDry (0.5f - 0.2f * x);
+                            fx.setLFORate (2.0f + x);
+                            fx.setLFODepth (0.01f + 0.005f * x);
+                        }
+
+                        auto block = juce::dsp::AudioBlock<float> (buffer);
+                        fx.process (juce::dsp::ProcessContextReplacing<float> (block));
+                    });
+
+                    auto nsPerSample = (double) result->getProperty ("nsPerSample");
+
+                    if (! automated)
+                        fixedNsPerSample.push_back (nsPerSample);
+                    else if (caseIndex < fixedNsPerSample.size())
+                        result->setProperty ("overheadRatio", nsPerSample / fixedNsPerSample[caseIndex]);
+
+                    ++caseIndex;
+                }
+            }
+        }
+    }
+}
+
+// the effect types of the graph cases, in chain order.
+static const char* getGraphEffectType (size_t index)
+{
+    const char* types[] = { "Delay", "Chorus", "Flanger" };
+    return types[index % 3];
+}
+
+template <typename Node>
+static juce::DynamicObject::Ptr runGraphCase (BenchmarkRunner& runner, const juce::String& caseName, Node& node,
+                                              const juce::AudioBuffer<float>& input, double sampleRate)
+{
+    juce::AudioBuffer<float> buffer (input.getNumChannels(), input.getNumSamples());
+
+    return runner.run (caseName, input.getNumSamples(), sampleRate, [&]
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            buffer.copyFrom (ch, 0, input, ch, 0, input.getNumSamples());
+
+        auto block = juce::dsp::AudioBlock<float> (buffer);
+        node.process (juce::dsp::ProcessContextReplacing<float> (block));
+    });
+}
+
+// a chain of 8 effects, which should cost about the sum of the same 8 run one by one, and the
+// three effect types sent in parallel.
+static void benchmarkEffectGraph (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+
+    juce::AudioBuffer<float> input (2, blockSize);
+    juce::Random random (1);
+
+    for (int ch = 0; ch < input.getNumChannels(); ++ch)
+        for (int i = 0; i < blockSize; ++i)
+            input.setSample (ch, i, random.nextFloat() * 0.5f - 0.25f);
+
+    if (settings.shouldRun ("EffectGraph/chain8"))
+    {
+        auto sumOfParts = 0.0;
+
+        for (size_t i = 0; i < 8; ++i)
+        {
+            Effect<float> fx;
+            prepareEffect (fx, getGraphEffectType (i), sampleRate, blockSize);
+
+            auto result = runGraphCase (runner, juce::String ("EffectGraph/single/") + getGraphEffectType (i), fx, input, sampleRate);
+            sumOfParts += (double) result->getProperty ("nsPerSample");
+        }
+
+        using Fx = Effect<float>;
+        EffectChain<Fx, Fx, Fx, Fx, Fx, Fx, Fx, Fx> chain;
+        chain.prepare ({ sampleRate, (juce::uint32) blockSize, 2 });
+
+        auto prepareNode = [&] (size_t index, Fx& fx) { prepareEffect (fx, getGraphEffectType (index), sampleRate, blockSize); };
+        prepareNode (0, chain.get<0>());    prepareNode (1, chain.get<1>());
+        prepareNode (2, chain.get<2>());    prepareNode (3, chain.get<3>());
+        prepareNode (4, chain.get<4>());    prepareNode (5, chain.get<5>());
+        prepareNode (6, chain.get<6>());    prepareNode (7, chain.get<7>());
+
+        auto result = runGraphCase (runner, "EffectGraph/chain8", chain, input, sampleRate);
+        result->setProperty ("sumOfPartsNsPerSample", sumOfParts);
+        result->setProperty ("overheadRatio", (double) result->getProperty ("nsPerSample") / sumOfParts);
+    }
+
+    if (settings.shouldRun ("EffectGraph/sends3"))
+    {
+        EffectSends<float, Effect<float>, Effect<float>, Effect<float>> sends;
+        sends.prepare ({ sampleRate, (juce::uint32) blockSize, 2 });
+        prepareEffect (sends.get<0>(), getGraphEffectType (0), sampleRate, blockSize);
+        prepareEffect (sends.get<1>(), getGraphEffectType (1), sampleRate, blockSize);
+        prepareEffect (sends.get<2>(), getGraphEffectType (2), sampleRate, blockSize);
+
+        for (size_t i = 0; i < sends.numSends; ++i)
+            sends.setSendLevel (i, 0.3f);
+
+        runGraphCase (runner, "EffectGraph/sends3", sends, input, sampleRate);
+    }
+}
+
+// a MIDI event every eventInterval samples of a block, alternately starting and releasing notes.
+static juce::MidiBuffer makeDenseMIDI (int blockSize, int eventInterval)
+{
+    juce::MidiBuffer midi;
+
+    for (int i = 0, position = 0; position < blockSize; ++i, position += eventInterval)
+    {
+        auto note = 48 + (i / 2) % 24;
+        midi.addEvent (i % 2 == 0 ? juce::MidiMessage::noteOn (1, note, 0.8f)
+                                  : juce::MidiMessage::noteOff (1, note), position);
+    }
+
+    return midi;
+}
+
+// the effect of a synth under a MIDI event every 32 samples, the shortest stretch juce::Synthesiser
+// renders between events: /perSubBlock runs it once per stretch, as it ran when renderVoices
+// called it, and /masterBus once per block through FMSynthesizer::processEffects, as
+// SynthAudioSource now does. The voices cost the same in both, so the difference is the effect.
+static void benchmarkDenseMIDI (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const int blockSize = 512, eventInterval = 32, numVoices = 4;
+    const double sampleRate = 48000.0;
+
+    for (auto fxType : { "Delay", "Chorus", "MultiTap", "CrossFeedback" })
+    {
+        auto perSubBlockName = juce::String ("denseMIDI/perSubBlock/") + fxType;
+        auto masterBusName   = juce::String ("denseMIDI/masterBus/") + fxType;
+
+        if (! settings.shouldRun (perSubBlockName) && ! settings.shouldRun (masterBusName))
+            continue;
+
+        auto midi = makeDenseMIDI (blockSize, eventInterval);
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        double nsPerSample[2] = {};
+
+        for (auto masterBus : { false, true })
+        {
+            FMSynthesizer synth;
+            prepareSynth (synth, numVoices, sampleRate, VoiceEngine::block);
+            synth.prepareMasterBus (blockSize);
+            synth.setFXType (fxType);
+            synth.setFXParameters (getFXPreset (fxType));
+
+            auto result = runner.run (masterBus ? masterBusName : perSubBlockName, blockSize, sampleRate, [&]
+            {
+                buffer.clear();
+
+                if (masterBus)
+                {
+                    synth.renderNextBlock (buffer, midi, 0, blockSize);
+                    synth.processEffects (buffer, 0, blockSize);
+                }
+                else
+                {
+                    for (int start = 0; start < blockSize; start += eventInterval)
+                    {
+                        synth.renderNextBlock (buffer, midi, start, eventInterval);
+                        synth.processEffects (buffer, start, eventInterval);
+                    }
+                }
+            });
+
+            result->setProperty ("eventInterval", eventInterval);
+            nsPerSample[masterBus ? 1 : 0] = (double) result->getProperty ("nsPerSample");
+
+            if (masterBus && nsPerSample[0] > 0.0)
+                result->setProperty ("speedUpOverPerSubBlock", nsPerSample[0] / nsPerSample[1]);
+        }
+    }
+}
+
+//==============================================================================
+static volatile float benchmarkSink = 0.0f;   // keeps the optimiser from discarding benchmarked output
+
+// THD+N of a phase-to-sine function against the exact sine, in dB.
+template <typename SineFunction>
+static double measureTHDPlusNoise (SineFunction&& sine, double frequency, double sampleRate)
+{
+    Phasor phasor;
+    phasor.setFrequency (frequency, sampleRate);
+
+    double signalPower = 0.0, errorPower = 0.0;
+
+    for (int i = 0; i < (int) sampleRate; ++i)
+    {
+        auto phase = phasor.advance();
+        auto exact = std::sin (juce::MathConstants<double>::twoPi * phase / Phasor::phasePerCycle);
+        auto error = (double) sine (phase) - exact;
+        signalPower += exact * exact;
+        errorPower  += error * error;
+    }
+
+    return 10.0 * std::log10 (juce::jmax (errorPower, 1.0e-30) / signalPower);
+}
+
+template <int tableBits, SineInterpolation interpolation>
+static void benchmarkSineTable (BenchmarkRunner& runner, const BenchmarkSettings& settings, const char* interpolationName)
+{
+    auto caseName = "Oscillator/SineTable<" + juce::String (tableBits) + ">/" + interpolationName;
+
+    if (! settings.shouldRun (caseName))
+        return;
+
+    const int blockSize = 512;
+    const double sampleRate = 48000.0, frequency = 997.0;
+    auto& table = SineTable<tableBits>::getInstance();
+    auto lookup = [&table] (juce::uint32 phase) { return table.template lookup<interpolation> (phase); };
+
+    Phasor phasor;
+    phasor.setFrequency (frequency, sampleRate);
+    std::vector<float> output ((size_t) blockSize);
+
+    auto result = runner.run (caseName, blockSize, sampleRate, [&]
+    {
+        for (auto& x : output)
+            x = lookup (phasor.advance());
+
+        benchmarkSink = output[0];
+    });
+
+    result->setProperty ("tableSize", SineTable<tableBits>::size);
+    result->setProperty ("thdPlusNoiseDb", measureTHDPlusNoise (lookup, frequency, sampleRate));
+}
+
+// per-sample std::sin of a growing double angle, as FMVoice used to do, against the table oscillators.
+static void benchmarkOscillators (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    if (settings.shouldRun ("Oscillator/std::sin"))
+    {
+        const int blockSize = 512;
+        const double sampleRate = 48000.0, frequency = 997.0;
+        auto angle = 0.0, angleDelta = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        std::vector<float> output ((size_t) blockSize);
+
+        runner.run ("Oscillator/std::sin", blockSize, sampleRate, [&]
+        {
+            for (auto& x : output)
+            {
+                x = (float) std::sin (angle);
+                angle += angleDelta;
+            }
+
+            benchmarkSink = output[0];
+        });
+    }
+
+    benchmarkSineTable<9,  SineInterpolation::none>   (runner, settings, "none");
+    benchmarkSineTable<9,  SineInterpolation::linear> (runner, settings, "linear");
+    benchmarkSineTable<11, SineInterpolation::none>   (runner, settings, "none");
+    benchmarkSineTable<11, SineInterpolation::linear> (runner, settings, "linear");
+    benchmarkSineTable<13, SineInterpolation::linear> (runner, settings, "linear");
+}
+
+//==============================================================================
+// a note every 200 blocks, released after 100, so every ADSR stage is timed.
+static void triggerEnvelopes (ADSREnvelope& carrier, ADSREnvelope& modulator, int& blockCount)
+{
+    for (auto* envelope : { &carrier, &modulator })
+    {
+        if (blockCount % 200 == 0)
+            envelope->noteOn();
+        else if (blockCount % 200 == 100)
+            envelope->noteOff();
+    }
+
+    ++blockCount;
+}
+
+// the carrier and modulator envelopes of one voice, block by block and per sample.
+static void benchmarkEnvelopes (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+    auto p = getBenchmarkFMParameters();
+    p.carrierAttackTime = p.modulatorAttackTime = 0.005f;
+    p.carrierDecayTime  = p.modulatorDecayTime  = 0.2f;
+    p.carrierReleaseTime = p.modulatorReleaseTime = 0.3f;
+
+    ADSREnvelope carrierEnvelope, modulatorEnvelope;
+    std::vector<float> carrierLevels ((size_t) blockSize), modulatorLevels ((size_t) blockSize);
+
+    for (auto* envelope : { &carrierEnvelope, &modulatorEnvelope })
+        envelope->setSampleRate (sampleRate);
+
+    carrierEnvelope.setTimes (p.getCarrierTimes());
+    modulatorEnvelope.setTimes (p.getModulatorTimes());
+
+    if (settings.shouldRun ("Envelope/block"))
+    {
+        auto blockCount = 0;
+
+        runner.run ("Envelope/block", blockSize, sampleRate, [&]
+        {
+            triggerEnvelopes (carrierEnvelope, modulatorEnvelope, blockCount);
+
+            for (int i = 0; i < blockSize; i += FMVoice::maxKernelBlockSize)
+            {
+                carrierEnvelope.getNextBlock (carrierLevels.data() + i, FMVoice::maxKernelBlockSize);
+                modulatorEnvelope.getNextBlock (modulatorLevels.data() + i, FMVoice::maxKernelBlockSize);
+            }
+
+            benchmarkSink = carrierLevels[0] + modulatorLevels[0];
+        });
+    }
+
+    if (settings.shouldRun ("Envelope/perSample"))
+    {
+        auto blockCount = 0;
+
+        runner.run ("Envelope/perSample", blockSize, sampleRate, [&]
+        {
+            triggerEnvelopes (carrierEnvelope, modulatorEnvelope, blockCount);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                carrierLevels[(size_t) i]   = carrierEnvelope.getNextSample();
+                modulatorLevels[(size_t) i] = modulatorEnvelope.getNextSample();
+            }
+
+            benchmarkSink = carrierLevels[0] + modulatorLevels[0];
+        });
+    }
+}
+
+//==============================================================================
+// a feedback delay, y[n] = x[n] + feedback * y[n - delay], over long delay times. The per-sample case
+// wraps its pointers with comparisons, as Effect::process did; the block case copies whole spans of
+// the ring buffer with DelayLine::read and DelayLine::write.
+static void benchmarkDelayLine (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+    const float feedback = 0.5f;
+    auto delayTimes = settings.quick ? std::vector<double> { 1.0 } : std::vector<double> { 0.25, 1.0, 2.0 };
+
+    for (auto delayTime : delayTimes)
+    {
+        auto delaySamples = (size_t) (delayTime * sampleRate);
+
+        DelayLine<float> dline;
+        dline.resize ((size_t) (2.0 * sampleRate) + 1);
+
+        std::vector<float> input ((size_t) blockSize), output ((size_t) blockSize), delayed ((size_t) blockSize);
+        juce::Random random (1);
+
+        for (auto& x : input)
+            x = random.nextFloat() * 0.5f - 0.25f;
+
+        if (settings.shouldRun ("DelayLine/feedback/perSample"))
+        {
+            auto length = (size_t) (2.0 * sampleRate) + 1;
+            size_t writePointer = 0, readPointer = length - delaySamples;
+            dline.clear();
+
+            auto result = runner.run ("DelayLine/feedback/perSample", blockSize, sampleRate, [&]
+            {
+                for (size_t i = 0; i < (size_t) blockSize; ++i)
+                {
+                    output[i] = input[i] + feedback * dline.get (readPointer);
+                    dline.push (writePointer, output[i]);
+
+                    if (++writePointer >= length)  writePointer = 0;
+                    if (++readPointer  >= length)  readPointer  = 0;
+                }
+
+                benchmarkSink = output[0];
+            });
+
+            result->setProperty ("delayTime", delayTime);
+        }
+
+        if (settings.shouldRun ("DelayLine/feedback/block"))
+        {
+            size_t writePointer = 0;
+            dline.clear();
+
+            auto result = runner.run ("DelayLine/feedback/block", blockSize, sampleRate, [&]
+            {
+                // spans longer than the delay would read samples not written yet
+                for (size_t done = 0; done < (size_t) blockSize;)
+                {
+                    auto numThisTime = juce::jmin ((size_t) blockSize - done, delaySamples);
+
+                    dline.read (writePointer - delaySamples, delayed.data(), numThisTime);
+                    juce::FloatVectorOperations::copy (output.data() + done, input.data() + done, (int) numThisTime);
+                    juce::FloatVectorOperations::addWithMultiply (output.data() + done, delayed.data(), feedback, (int) numThisTime);
+                    dline.write (writePointer, output.data() + done, numThisTime);
+
+                    writePointer += numThisTime;
+                    done += numThisTime;
+                }
+
+                benchmarkSink = output[0];
+            });
+
+            result->setProperty ("delayTime", delayTime);
+        }
+    }
+}
+
+// a flanger-like bank of 16 taps whose delays sweep around 5 ms, read with each interpolation.
+template <DelayInterpolation interpolation>
+static void benchmarkDelayInterpolation (BenchmarkRunner& runner, const BenchmarkSettings& settings, const char* interpolationName)
+{
+    auto caseName = juce::String ("DelayLine/taps16/") + interpolationName;
+
+    if (! settings.shouldRun (caseName))
+        return;
+
+    const int blockSize = 512, numTaps = 16;
+    const double sampleRate = 48000.0;
+
+    DelayLine<float> dline;
+    dline.resize (4096);
+
+    std::vector<float> input ((size_t) blockSize), output ((size_t) blockSize), delays ((size_t) (blockSize * numTaps));
+    std::array<float, numTaps> taps, allpassStates {};
+    juce::Random random (1);
+
+    for (auto& x : input)
+        x = random.nextFloat() * 0.5f - 0.25f;
+
+    // each tap sweeps 4 to 6 ms at its own rate and phase
+    for (int i = 0; i < blockSize; ++i)
+        for (int t = 0; t < numTaps; ++t)
+            delays[(size_t) (i * numTaps + t)] = (float) (sampleRate * (0.005 + 0.001 * std::sin (0.0005 * (t + 1) * i + t)));
+
+    size_t writePointer = 0;
+
+    auto result = runner.run (caseName, blockSize, sampleRate, [&]
+    {
+        dline.write (writePointer, input.data(), (size_t) blockSize);
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            dline.readTaps<interpolation> (writePointer + (size_t) i, delays.data() + i * numTaps, taps.data(), numTaps, allpassStates.data());
+            output[(size_t) i] = std::accumulate (taps.begin(), taps.end(), 0.0f);
+        }
+
+        writePointer += (size_t) blockSize;
+        benchmarkSink = output[0];
+    });
+
+    result->setProperty ("taps", numTaps);
+    result->setProperty ("nsPerTap", (double) result->getProperty ("nsPerSample") / numTaps);
+}
+
+static void benchmarkDelayInterpolations (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    benchmarkDelayInterpolation<DelayInterpolation::linear>   (runner, settings, "linear");
+    benchmarkDelayInterpolation<DelayInterpolation::lagrange> (runner, settings, "lagrange");
+    benchmarkDelayInterpolation<DelayInterpolation::hermite>  (runner, settings, "hermite");
+    benchmarkDelayInterpolation<DelayInterpolation::allpass>  (runner, settings, "allpass");
+}
+
+// 16 LFO outputs with their own phase offsets, as 16 modulated taps would use, generated per
+// block by LFOBank in each shape, against std::sin per output and sample.
+static void benchmarkLFOs (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+    constexpr size_t numOutputs = 16;
+
+    if (settings.shouldRun ("LFO/std::sin"))
+    {
+        std::vector<float> output ((size_t) blockSize);
+        double phase = 0.0, increment = juce::MathConstants<double>::twoPi * 2.0 / sampleRate;
+
+        auto result = runner.run ("LFO/std::sin", blockSize, sampleRate, [&]
+        {
+            for (size_t out = 0; out < numOutputs; ++out)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                    output[(size_t) i] = (float) std::sin (phase + increment * i + (double) out / numOutputs);
+
+                benchmarkSink = output[0];
+            }
+
+            phase += increment * blockSize;
+        });
+
+        result->setProperty ("outputs", (int) numOutputs);
+        result->setProperty ("nsPerOutput", (double) result->getProperty ("nsPerSample") / (double) numOutputs);
+    }
+
+    for (auto shape : { LFOShape::sine, LFOShape::triangle, LFOShape::randomSmooth })
+    {
+        auto caseName = juce::String ("LFO/") + (shape == LFOShape::sine ? "sine" : shape == LFOShape::triangle ? "triangle" : "randomSmooth");
+
+        if (! settings.shouldRun (caseName))
+            continue;
+
+        LFOBank<numOutputs> lfo;
+        lfo.prepare (sampleRate, (size_t) blockSize);
+        lfo.setFrequency (2.0);
+        lfo.setShape (shape);
+
+        for (size_t out = 0; out < numOutputs; ++out)
+            lfo.setPhaseOffset (out, (double) out / numOutputs);
+
+        auto result = runner.run (caseName, blockSize, sampleRate, [&]
+        {
+            lfo.generate ((size_t) blockSize);
+            benchmarkSink = lfo.getOutput (numOutputs - 1)[0];
+        });
+
+        result->setProperty ("outputs", (int) numOutputs);
+        result->setProperty ("nsPerOutput", (double) result->getProperty ("nsPerSample") / (double) numOutputs);
+    }
+}
+
+// the multi-tap mode of Effect with 1 to 32 taps spread over a second, each panned and
+// filtered; the cost per tap should stay flat, as all taps share one delay line per channel.
+static void benchmarkMultiTap (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+
+    for (size_t numTaps : { 1, 4, 8, 32 })
+    {
+        auto caseName = "MultiTap/taps" + juce::String ((int) numTaps);
+
+        if (! settings.shouldRun (caseName))
+            continue;
+
+        Effect<float> fx;
+        prepareEffect (fx, "MultiTap", sampleRate, blockSize);
+        fx.setNumTaps (numTaps);
+
+        for (size_t i = 0; i < numTaps; ++i)
+        {
+            DelayTap tap;
+            tap.delayTime = 0.03f * (float) (i + 1);
+            tap.gain      = 1.0f / (float) numTaps;
+            tap.pan       = (float) i / (float) numTaps * 2.0f - 1.0f;
+            tap.cutoff    = 2000.0f + 500.0f * (float) i;
+            fx.setTap (i, tap);
+        }
+
+        auto input = makeNoise (2, blockSize);
+        juce::AudioBuffer<float> buffer (2, blockSize);
+
+        auto result = runner.run (caseName, blockSize, sampleRate, [&]
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.copyFrom (ch, 0, input, ch, 0, blockSize);
+
+            auto block = juce::dsp::AudioBlock<float> (buffer);
+            fx.process (juce::dsp::ProcessContextReplacing<float> (block));
+        });
+
+        result->setProperty ("taps", (int) numTaps);
+        result->setProperty ("nsPerTap", (double) result->getProperty ("nsPerSample") / (double) numTaps);
+    }
+}
+
+// the cross-feedback mode of an Effect of 2 to 16 channels: "full" mixes every channel into
+// every other, with a delay of its own on each channel; "independent" runs one feedback delay
+// per channel with a shared delay time, which is one contiguous frame read and one multiply-add
+// across the SIMD lanes per sample. nsPerChannel shows how the cost grows with the channels,
+// which is about linearly, as the data moved per frame grows with them.
+template <size_t numChannels>
+static void benchmarkCrossFeedback (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+
+    for (auto independent : { false, true })
+    {
+        auto caseName = juce::String ("CrossFeedback/") + (independent ? "independent" : "full")
+                          + "/channels" + juce::String ((int) numChannels);
+
+        if (! settings.shouldRun (caseName))
+            continue;
+
+        Effect<float, numChannels> fx;
+        fx.prepare ({ sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels });
+        fx.setSampleRate ((float) sampleRate);
+        fx.setFXType (EffectType::crossFeedback);
+        fx.setFeedback (0.5f);
+        fx.setWetDry (0.5f);
+
+        typename CrossFeedbackDelay<float, numChannels>::Matrix matrix;
+
+        for (size_t row = 0; row < numChannels; ++row)
+            for (size_t column = 0; column < numChannels; ++column)
+                matrix[row][column] = independent ? (row == column ? 1.0f : 0.0f) : 1.0f / (float) numChannels;
+
+        fx.setFeedbackMatrix (matrix);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            fx.setDelayTime (ch, independent ? 0.2f : 0.2f + 0.01f * (float) ch);
+
+        fx.reset();
+
+        auto noise = makeNoise ((int) numChannels, blockSize);
+        juce::AudioBuffer<float> buffer ((int) numChannels, blockSize);
+
+        auto result = runner.run (caseName, blockSize, sampleRate, [&]
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.copyFrom (ch, 0, noise, ch, 0, blockSize);
+
+            auto block = juce::dsp::AudioBlock<float> (buffer);
+            fx.process (juce::dsp::ProcessContextReplacing<float> (block));
+        });
+
+        result->setProperty ("channels", (int) numChannels);
+        result->setProperty ("nsPerChannel", (double) result->getProperty ("nsPerSample") / (double) numChannels);
+    }
+}
+
+static void benchmarkCrossFeedbacks (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    benchmarkCrossFeedback<2>  (runner, settings);
+    benchmarkCrossFeedback<4>  (runner, settings);
+    benchmarkCrossFeedback<8>  (runner, settings);
+    benchmarkCrossFeedback<16> (runner, settings);
+}
+
+// an impulse response like a room's: noise decaying by 60 dB over its length.
+static juce::AudioBuffer<float> makeImpulseResponse (int numChannels, int numSamples)
+{
+    auto ir = makeNoise (numChannels, numSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            ir.setSample (ch, i, ir.getSample (ch, i) * std::pow (0.001f, (float) i / (float) numSamples));
+
+    return ir;
+}
+
+// largest difference between ConvolutionReverb and direct convolution with a short impulse response.
+static float measureConvolutionError (int blockSize, double sampleRate)
+{
+    const int irLength = 2000, numSamples = 8192;
+    auto ir = makeImpulseResponse (1, irLength);
+    auto input = makeNoise (1, numSamples);
+
+    ConvolutionReverb reverb;
+    reverb.setImpulseResponse (ir, sampleRate);
+    reverb.setWetLevel (1.0f);
+    reverb.setDryLevel (0.0f);
+    reverb.prepare ({ sampleRate, (juce::uint32) blockSize, 1 });
+
+    juce::AudioBuffer<float> output (1, numSamples);
+    output.copyFrom (0, 0, input, 0, 0, numSamples);
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        auto block = juce::dsp::AudioBlock<float> (output).getSubBlock ((size_t) start, (size_t) juce::jmin (blockSize, numSamples - start));
+        reverb.process (juce::dsp::ProcessContextReplacing<float> (block));
+    }
+
+    // the reverb scales the impulse response to unit energy
+    auto energy = 0.0;
+
+    for (int i = 0; i < irLength; ++i)
+        energy += (double) ir.getSample (0, i) * ir.getSample (0, i);
+
+    auto gain = 1.0 / std::sqrt (energy);
+    auto latency = reverb.getLatencySamples();
+    auto maxError = 0.0f;
+
+    for (int n = latency; n < numSamples; ++n)
+    {
+        auto expected = 0.0;
+
+        for (int k = 0; k <= juce::jmin (irLength - 1, n - latency); ++k)
+            expected += gain * ir.getSample (0, k) * input.getSample (0, n - latency - k);
+
+        maxError = juce::jmax (maxError, (float) std::abs (expected - output.getSample (0, n)));
+    }
+
+    return maxError;
+}
+
+// a stereo convolution reverb with impulse responses of 1 to 10 seconds, partitioned uniformly
+// by the block size or non-uniformly with the tail on a worker thread; cpuPercent is the share
+// of one core the reverb needs in real time. The reverbs run offline: faster than real time,
+// most tail jobs come due before the worker wakes and are run on the calling thread, so the
+// non-uniform cases time the whole convolution, head and tail; lateTailJobs is the share of
+// tail jobs run that way.
+static void benchmarkConvolution (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    for (auto partitioning : { ConvolutionPartitioning::uniform, ConvolutionPartitioning::nonUniform })
+    {
+        auto nonUniform = partitioning == ConvolutionPartitioning::nonUniform;
+        auto caseName = juce::String (nonUniform ? "Convolution/nonUniform" : "Convolution/uniform");
+
+        if (! settings.shouldRun (caseName))
+            continue;
+
+        for (auto sampleRate : getSampleRates (settings))
+        {
+            for (auto irSeconds : { 1.0, 4.0, 10.0 })
+            {
+                auto ir = makeImpulseResponse (2, (int) (irSeconds * sampleRate));
+
+                for (auto blockSize : getBlockSizes (settings))
+                {
+                    ConvolutionReverb reverb;
+                    reverb.setPartitioning (partitioning);
+                    reverb.setRealtime (false);
+                    reverb.setImpulseResponse (ir, sampleRate);
+                    reverb.prepare ({ sampleRate, (juce::uint32) blockSize, 2 });
+
+                    auto input = makeNoise (2, blockSize);
+                    auto result = runGraphCase (runner, caseName, reverb, input, sampleRate);
+
+                    result->setProperty ("irSeconds", irSeconds);
+                    result->setProperty ("latencySamples", reverb.getLatencySamples());
+                    result->setProperty ("cpuPercent", 100.0 / (double) result->getProperty ("realtimeFactor"));
+
+                    if (reverb.hasTail())
+                        result->setProperty ("lateTailJobs", reverb.getNumLateTailJobs() / (double) juce::jmax (1, reverb.getNumTailJobs()));
+
+                    if (irSeconds == 1.0 && ! nonUniform)
+                        result->setProperty ("maxErrorVsDirect", measureConvolutionError (blockSize, sampleRate));
+                }
+            }
+        }
+    }
+}
+
+// a stereo FDNReverb of 8 and 16 lines, with the cost of one FMVoice, timed by rendering 16
+// voices as in renderVoices/block, as a reference: fmVoicesPerChannel is the cost of the
+// reverb per channel over the cost of a voice, which should be below 1. decayDb is the drop
+// in the energy of the tail of an impulse over one second, which should be about 30 dB for the
+// decay time of 2 seconds.
+template <size_t numLines>
+static void benchmarkFDNReverb (BenchmarkRunner& runner, const BenchmarkSettings& settings, double nsPerVoiceSample)
+{
+    const int blockSize = 512;
+    const double sampleRate = 48000.0;
+    auto caseName = juce::String ("FDNReverb/lines") + juce::String ((int) numLines);
+
+    if (! settings.shouldRun (caseName))
+        return;
+
+    FDNReverb<float, numLines> reverb;
+    reverb.setDecayTime (2.0f);
+    reverb.setWetLevel (1.0f);
+    reverb.setDryLevel (0.0f);
+    reverb.prepare ({ sampleRate, (juce::uint32) blockSize, 2 });
+
+    // energy of the impulse response in the second half-second and in the third second
+    juce::AudioBuffer<float> buffer (2, blockSize);
+    double energies[2] = { 0.0, 0.0 };
+
+    for (int start = 0; start < 3 * (int) sampleRate; start += blockSize)
+    {
+        buffer.clear();
+
+        if (start == 0)
+            buffer.setSample (0, 0, 1.0f);
+
+        auto block = juce::dsp::AudioBlock<float> (buffer);
+        reverb.process (juce::dsp::ProcessContextReplacing<float> (block));
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            auto t = (double) (start + i) / sampleRate;
+            auto energy = (double) buffer.getSample (0, i) * buffer.getSample (0, i)
+                        + (double) buffer.getSample (1, i) * buffer.getSample (1, i);
+
+            if (t >= 0.5 && t < 1.0)        energies[0] += 2.0 * energy;
+            else if (t >= 2.0 && t < 3.0)   energies[1] += energy;
+        }
+    }
+
+    reverb.reset();
+
+    auto input = makeNoise (2, blockSize);
+    auto result = runGraphCase (runner, caseName, reverb, input, sampleRate);
+    auto nsPerChannel = (double) result->getProperty ("nsPerSample") / 2.0;
+
+    result->setProperty ("lines", (int) numLines);
+    result->setProperty ("nsPerChannel", nsPerChannel);
+    result->setProperty ("fmVoicesPerChannel", nsPerChannel / nsPerVoiceSample);
+    result->setProperty ("decayDb", 10.0 * std::log10 (energies[0] / juce::jmax (1.0e-30, energies[1])) / 1.75);
+}
+
+static void benchmarkFDNReverbs (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    if (! settings.shouldRun ("FDNReverb/lines8") && ! settings.shouldRun ("FDNReverb/lines16"))
+        return;
+
+    const int numVoices = 16, blockSize = 512;
+    const double sampleRate = 48000.0;
+
+    FMSynthesizer synth;
+    prepareSynth (synth, numVoices, sampleRate, VoiceEngine::block);
+    juce::AudioBuffer<float> buffer (2, blockSize);
+
+    auto reference = runner.run ("FDNReverb/fmVoiceReference", blockSize, sampleRate, [&]
+    {
+        buffer.clear();
+        synth.renderVoices (buffer, 0, blockSize);
+    });
+
+    auto nsPerVoiceSample = (double) reference->getProperty ("nsPerSample") / numVoices;
+    reference->setProperty ("nsPerVoiceSample", nsPerVoiceSample);
+
+    benchmarkFDNReverb<8>  (runner, settings, nsPerVoiceSample);
+    benchmarkFDNReverb<16> (runner, settings, nsPerVoiceSample);
+}
+
+// largest difference between the frames StreamingSTFT::process() emits for input in blocks of
+// varying size and the frames of processFrames() for the whole input, which should be zero.
+static float measureStreamingSTFTError (StreamingSTFT& stft, const juce::AudioBuffer<float>& input)
+{
+    auto numSamples = (size_t) input.getNumSamples();
+    auto numBins = stft.getNumBins();
+    auto numFrames = stft.getNumFrames (numSamples);
+
+    std::vector<float> real (numFrames * numBins), imag (numFrames * numBins);
+    stft.processFrames (input.getReadPointer (0), numSamples, real.data(), imag.data());
+
+    auto maxError = 0.0f;
+    juce::Random random (2);
+    stft.reset();
+
+    for (size_t start = 0; start < numSamples;)
+    {
+        auto n = juce::jmin ((size_t) (1 + random.nextInt (700)), numSamples - start);
+
+        stft.process (input.getReadPointer (0, (int) start), n, [&] (juce::int64 frame, const float* re, const float* im)
+        {
+            for (size_t k = 0; k < numBins; ++k)
+            {
+                maxError = juce::jmax (maxError, std::abs (re[k] - real[(size_t) frame * numBins + k]));
+                maxError = juce::jmax (maxError, std::abs (im[k] - imag[(size_t) frame * numBins + k]));
+            }
+        });
+
+        start += n;
+    }
+
+    if ((size_t) stft.getNumFramesEmitted() != numFrames)
+        return std::numeric_limits<float>::infinity();
+
+    return maxError;
+}
+
+// largest difference between the bins of the first frame of processFrames() and a direct DFT
+// of the windowed, zero-padded input.
+static float measureSTFTErrorVsDFT (StreamingSTFT& stft, const juce::AudioBuffer<float>& input)
+{
+    auto numBins = stft.getNumBins();
+    auto fftSize = stft.getFFTSize();
+    std::vector<float> real (numBins), imag (numBins);
+    stft.processFrames (input.getReadPointer (0), stft.getWindowSize(), real.data(), imag.data());
+
+    auto maxError = 0.0f;
+
+    for (size_t k = 0; k < numBins; ++k)
+    {
+        std::complex<double> expected;
+
+        for (size_t n = 0; n < stft.getWindowSize(); ++n)
+        {
+            auto w = 0.5 - 0.5 * std::cos (juce::MathConstants<double>::twoPi * (double) n / (double) stft.getWindowSize());
+            expected += w * input.getSample (0, (int) n)
+                          * std::polar (1.0, -juce::MathConstants<double>::twoPi * (double) (k * n) / (double) fftSize);
+        }
+
+        maxError = juce::jmax (maxError, (float) std::abs (expected - std::complex<double> (real[k], imag[k])));
+    }
+
+    return maxError;
+}
+
+// StreamingSTFT with a 1024-sample window and a hop of 256, zero-padded to 2048, fed a block
+// at a time as in an audio callback, and processFrames() on 10 seconds of input for offline
+// use; nsPerFrame is the cost of a frame, which the streaming case pays every hopSize samples.
+static void benchmarkSTFT (BenchmarkRunner& runner, const BenchmarkSettings& settings)
+{
+    const size_t windowSize = 1024, hopSize = 256, fftSize = 2048;
+
+    StreamingSTFT stft;
+    stft.prepare (windowSize, hopSize, fftSize);
+
+    if (settings.shouldRun ("STFT/streaming"))
+    {
+        for (auto sampleRate : getSampleRates (settings))
+        {
+            for (auto blockSize : getBlockSizes (settings))
+            {
+                auto input = makeNoise (1, blockSize);
+                stft.reset();
+
+                auto result = runner.run ("STFT/streaming", blockSize, sampleRate, [&]
+                {
+                    stft.process (input.getReadPointer (0), (size_t) blockSize, [] (juce::int64, const float* re, const float*)
+                    {
+                        benchmarkSink = re[1];
+                    });
+                });
+
+                result->setProperty ("nsPerFrame", (double) result->getProperty ("nsPerSample") * (double) hopSize);
+                result->setProperty ("maxErrorVsOffline", measureStreamingSTFTError (stft, makeNoise (1, 48000)));
+            }
+        }
+    }
+
+    if (settings.shouldRun ("STFT/offline"))
+    {
+        const double sampleRate = 48000.0;
+        auto input = makeNoise (1, (int) (10.0 * sampleRate));
+        auto numFrames = stft.getNumFrames ((size_t) input.getNumSamples());
+        std::vector<float> real (numFrames * stft.getNumBins()), imag (numFrames * stft.getNumBins());
+
+        auto result = runner.run ("STFT/offline", input.getNumSamples(), sampleRate, [&]
+        {
+            stft.processFrames (input.getReadPointer (0), (size_t) input.getNumSamples(), real.data(), imag.data());
+        });
+
+        result->setProperty ("frames", (int) numFrames);
+        result->setProperty ("nsPerFrame", (double) result->getProperty ("nsPerSample") * (double) input.getNumSamples() / (double) numFrames);
+        result->setProperty ("maxErrorVsDFT", measureSTFTErrorVsDFT (stft, input));
+    }
+}
+
+//==============================================================================
+static void runBenchmarks (const juce::ArgumentList& args)
+{
+    BenchmarkSettings settings;
+    settings.quick = args.containsOption ("--quick");
+
+    if (args.containsOption ("--seconds"))
+        settings.secondsPerCase = args.getValueForOption ("--seconds").getDoubleValue();
+
+    if (args.containsOption ("--filter"))
+        settings.filter = args.getValueForOption ("--filter");
+
+    BenchmarkRunner runner (settings);
+    benchmarkOscillators (runner, settings);
+    benchmarkEnvelopes (runner, settings);
+    benchmarkRenderVoices (runner, settings);
+    benchmarkVoicePool (runner, settings);
+    benchmarkPanning (runner, settings);
+    benchmarkRenderThreads (runner, settings);
+    benchmarkDelayLine (runner, settings);
+    benchmarkDelayInterpolations (runner, settings);
+    benchmarkLFOs (runner, settings);
+    benchmarkEffects (runner, settings);
+    benchmarkMultiTap (runner, settings);
+    benchmarkCrossFeedbacks (runner, settings);
+    benchmarkConvolution (runner, settings);
+    benchmarkFDNReverbs (runner, settings);
+    benchmarkSTFT (runner, settings);
+    benchmarkEffectGraph (runner, settings);
+    benchmarkDenseMIDI (runner, settings);
+
+    auto json = runner.toJSON();
+
+    if (args.containsOption ("--output"))
+    {
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--output"));
+
+        if (! file.replaceWithText (json))
+            juce::ConsoleApplication::fail ("Couldn't write " + file.getFullPathName());
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand ("--help|-h", "Usage: GCT535_Benchmark [--quick] [--seconds=2] [--filter=renderVoices] "
+                                     "[--output=results.json]", false);
+
+    app.addDefaultCommand ({ "",
+                             "[options]",
+                             "Times FMSynthesizer::renderVoices and Effect::process and prints the results as JSON",
+                             "Progress is printed to stderr, results to stdout unless --output is given.",
+                             runBenchmarks });
+
+    return app.findAndRunCommand (argc, argv);
+}
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+    Headless offline renderer: plays a standard MIDI file through the FM
+    synthesizer and effect of Homework #4 and writes the result to a WAV file,
+    as fast as the CPU allows.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/Synth.h"
+
+//==============================================================================
+struct RenderSettings
+{
+    juce::File midiFile, outputFile, impulseResponseFile;
+    juce::String preset = "Default";
+    juce::String fxType = "None";
+    double sampleRate   = 48000.0;
+    int blockSize       = 512;
+    int numChannels     = 2;
+    int bitsPerSample   = 24;
+    int numVoices       = 16;
+    float stereoSpread  = 0.0f;
+    double tailTime     = 2.0;
+    float reverbLevel   = 0.3f;
+    float fdnDecayTime  = 0.0f;
+};
+
+static juce::String getOption (const juce::ArgumentList& args, juce::StringRef option, const juce::String& defaultValue)
+{
+    return args.containsOption (option) ? args.getValueForOption (option) : defaultValue;
+}
+
+static RenderSettings parseSettings (const juce::ArgumentList& args)
+{
+    juce::StringArray files;
+
+    for (auto& arg : args.arguments)
+        if (! arg.isOption())
+            files.add (arg.text);
+
+    if (files.size() != 2)
+        juce::ConsoleApplication::fail ("Expected an input MIDI file and an output WAV file");
+
+    RenderSettings s;
+    s.midiFile      = juce::File::getCurrentWorkingDirectory().getChildFile (files[0]);
+    s.outputFile    = juce::File::getCurrentWorkingDirectory().getChildFile (files[1]);
+    s.preset        = getOption (args, "--preset", s.preset);
+    s.fxType        = getOption (args, "--fx", s.fxType);
+    s.sampleRate    = getOption (args, "--samplerate", juce::String (s.sampleRate)).getDoubleValue();
+    s.blockSize     = getOption (args, "--blocksize", juce::String (s.blockSize)).getIntValue();
+    s.bitsPerSample = getOption (args, "--bits", juce::String (s.bitsPerSample)).getIntValue();
+    s.numVoices     = getOption (args, "--voices", juce::String (s.numVoices)).getIntValue();
+    s.tailTime      = getOption (args, "--tail", juce::String (s.tailTime)).getDoubleValue();
+    s.stereoSpread  = getOption (args, "--spread", juce::String (s.stereoSpread)).getFloatValue();
+    s.reverbLevel   = getOption (args, "--reverb", juce::String (s.reverbLevel)).getFloatValue();
+    s.fdnDecayTime  = getOption (args, "--fdn", juce::String (s.fdnDecayTime)).getFloatValue();
+
+    if (args.containsOption ("--ir"))
+    {
+        s.impulseResponseFile = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--ir"));
+
+        if (! s.impulseResponseFile.existsAsFile())
+            juce::ConsoleApplication::fail ("Couldn't find impulse response: " + s.impulseResponseFile.getFullPathName());
+    }
+
+    if (! s.midiFile.existsAsFile())
+        juce::ConsoleApplication::fail ("Couldn't find MIDI file: " + s.midiFile.getFullPathName());
+
+    if (s.sampleRate <= 0.0 || s.blockSize <= 0 || s.tailTime < 0.0 || s.numVoices <= 0)
+        juce::ConsoleApplication::fail ("Invalid sample rate, block size, tail time or voice count");
+
+    return s;
+}
+
+// merge all tracks of the file into a single sequence with timestamps in seconds.
+static juce::MidiMessageSequence loadMidiFile (const juce::File& file)
+{
+    juce::FileInputStream stream (file);
+    juce::MidiFile midiFile;
+
+    if (! stream.openedOk() || ! midiFile.readFrom (stream))
+        juce::ConsoleApplication::fail ("Couldn't read MIDI file: " + file.getFullPathName());
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    juce::MidiMessageSequence sequence;
+
+    for (int track = 0; track < midiFile.getNumTracks(); ++track)
+        sequence.addSequence (*midiFile.getTrack (track), 0.0);
+
+    sequence.sort();
+    sequence.updateMatchedPairs();
+    return sequence;
+}
+
+// put a convolution reverb with the impulse response of the settings, if any, on the master bus.
+static void loadReverb (SynthAudioSource& synthAudioSource, const RenderSettings& s)
+{
+    if (s.impulseResponseFile == juce::File())
+        return;
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (s.impulseResponseFile));
+
+    if (reader == nullptr)
+        juce::ConsoleApplication::fail ("Couldn't read impulse response: " + s.impulseResponseFile.getFullPathName());
+
+    juce::AudioBuffer<float> impulseResponse ((int) reader->numChannels, (int) reader->lengthInSamples);
+    reader->read (&impulseResponse, 0, (int) reader->lengthInSamples, 0, true, true);
+    synthAudioSource.setReverb (impulseResponse, reader->sampleRate, s.reverbLevel);
+}
+
+static std::unique_ptr<juce::AudioFormatWriter> createWavWriter (const RenderSettings& s)
+{
+    s.outputFile.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream (s.outputFile.createOutputStream());
+
+    if (stream == nullptr)
+        juce::ConsoleApplication::fail ("Couldn't open output file: " + s.outputFile.getFullPathName());
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), s.sampleRate,
+                                                                                (unsigned int) s.numChannels,
+                                                                                s.bitsPerSample, {}, 0));
+    if (writer == nullptr)
+        juce::ConsoleApplication::fail ("Unsupported WAV format: " + juce::String (s.bitsPerSample) + " bits");
+
+    stream.release();   // the writer owns the stream now
+    return writer;
+}
+
+static void render (const juce::ArgumentList& args)
+{
+    auto settings = parseSettings (args);
+    auto sequence = loadMidiFile (settings.midiFile);
+    auto writer   = createWavWriter (settings);
+
+    juce::MidiKeyboardState keyboardState;
+    SynthAudioSource synthAudioSource (keyboardState, settings.numVoices);
+    synthAudioSource.prepareToPlay (settings.blockSize, settings.sampleRate);
+    synthAudioSource.setSampleRate();
+    synthAudioSource.setFMParameters (getFMPreset (settings.preset));
+    synthAudioSource.setStereoSpread (settings.stereoSpread);
+    synthAudioSource.setFXType (settings.fxType);
+    synthAudioSource.setFXParameters (getFXPreset (settings.fxType));
+    synthAudioSource.setRealtime (false);
+    loadReverb (synthAudioSource, settings);
+
+    if (settings.fdnDecayTime > 0.0f)
+        synthAudioSource.setFDNReverb (settings.fdnDecayTime, settings.reverbLevel);
+
+    juce::AudioBuffer<float> buffer (settings.numChannels, settings.blockSize);
+    juce::MidiBuffer midiMessages;
+
+    auto totalSamples = (juce::int64) std::ceil ((sequence.getEndTime() + settings.tailTime) * settings.sampleRate);
+    auto nextEvent = 0;
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    for (juce::int64 position = 0; position < totalSamples; position += settings.blockSize)
+    {
+        auto numSamples = (int) juce::jmin ((juce::int64) settings.blockSize, totalSamples - position);
+
+        midiMessages.clear();
+
+        for (; nextEvent < sequence.getNumEvents(); ++nextEvent)
+        {
+            auto& message = sequence.getEventPointer (nextEvent)->message;
+            auto samplePosition = (juce::int64) std::llround (message.getTimeStamp() * settings.sampleRate);
+
+            if (samplePosition >= position + numSamples)
+                break;
+
+            if (! message.isMetaEvent())
+                midiMessages.addEvent (message, (int) juce::jmax ((juce::int64) 0, samplePosition - position));
+        }
+
+        synthAudioSource.renderNextBlock (buffer, midiMessages, 0, numSamples);
+        writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+    }
+
+    writer.reset();
+
+    auto renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    auto audioSeconds  = (double) totalSamples / settings.sampleRate;
+
+    std::cout << "Rendered " << audioSeconds << " s of audio in " << renderSeconds << " s ("
+              << audioSeconds / juce::jmax (renderSeconds, 1.0e-9) << "x real time) to "
+              << settings.outputFile.getFullPathName() << std::endl;
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand ("--help|-h", "Usage: GCT535_Render input.mid output.wav [--preset=Default] [--fx=None] "
+                                     "[--samplerate=48000] [--blocksize=512] [--bits=24] [--tail=2] [--voices=16] [--spread=0] "
+                                     "[--ir=../audio/memchu_ir.wav] [--fdn=2] [--reverb=0.3]", false);
+
+    app.addDefaultCommand ({ "",
+                             "input.mid output.wav [options]",
+                             "Renders a MIDI file through the FM synthesizer to a WAV file",
+                             "Presets: Default, Bell, Brass, Electric Piano, Your Sound. Effects: None, Delay, Chorus, Flanger, MultiTap, CrossFeedback.",
+                             render });
+
+    return app.findAndRunCommand (argc, argv);
+}
@@ -0,0 +1,577 @@
+/*
+  ==============================================================================
+
+    Convolution.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Semaphore.h"
+
+//==============================================================================
+// One channel of uniformly partitioned overlap-save convolution: the impulse response is cut
+// into partitions of partitionSize samples, each transformed once, in prepare(), with an FFT
+// of twice that size. Every call to process() transforms the last two partitions of input,
+// keeps the spectrum in a frequency-domain delay line, multiplies the delay line by the
+// partitions of the impulse response and adds them up, so a partition of output costs one
+// forward and one inverse FFT plus one complex multiply-add per partition and bin. The
+// spectra are kept as separate real and imaginary arrays, so the multiply-add vectorises.
+class PartitionedConvolver
+{
+public:
+    // allocate the FFT and delay line and transform irLength samples of impulseResponse.
+    void prepare (const float* impulseResponse, size_t irLength, size_t newPartitionSize)
+    {
+        jassert (juce::isPowerOfTwo (newPartitionSize));
+
+        partitionSize = newPartitionSize;
+        numBins = partitionSize + 1;
+        numPartitions = juce::jmax ((size_t) 1, (irLength + partitionSize - 1) / partitionSize);
+        fft = std::make_unique<juce::dsp::FFT> (juce::roundToInt (std::log2 ((double) partitionSize)) + 1);
+
+        fftBuffer.assign (4 * partitionSize, 0.0f);
+        inputWindow.assign (2 * partitionSize, 0.0f);
+        irReal.assign (numPartitions * numBins, 0.0f);
+        irImag.assign (numPartitions * numBins, 0.0f);
+        delayReal.assign (numPartitions * numBins, 0.0f);
+        delayImag.assign (numPartitions * numBins, 0.0f);
+        sumReal.assign (numBins, 0.0f);
+        sumImag.assign (numBins, 0.0f);
+
+        // a partition of the impulse response followed by zeros, as overlap-save needs
+        for (size_t p = 0; p < numPartitions; ++p)
+        {
+            std::fill (fftBuffer.begin(), fftBuffer.end(), 0.0f);
+            auto start = p * partitionSize;
+            std::copy_n (impulseResponse + start, juce::jmin (partitionSize, irLength - juce::jmin (start, irLength)), fftBuffer.data());
+            forward (irReal.data() + p * numBins, irImag.data() + p * numBins);
+        }
+
+        head = 0;
+    }
+
+    void reset() noexcept
+    {
+        std::fill (inputWindow.begin(), inputWindow.end(), 0.0f);
+        std::fill (delayReal.begin(), delayReal.end(), 0.0f);
+        std::fill (delayImag.begin(), delayImag.end(), 0.0f);
+        head = 0;
+    }
+
+    size_t getPartitionSize() const noexcept                 { return partitionSize; }
+    size_t getNumPartitions() const noexcept                 { return numPartitions; }
+
+    // convolve the next partitionSize samples of input; output gets the partitionSize samples
+    // of the convolution that end with them. input and output may be the same.
+    void process (const float* input, float* output) noexcept
+    {
+        std::copy_n (inputWindow.data() + partitionSize, partitionSize, inputWindow.data());
+        std::copy_n (input, partitionSize, inputWindow.data() + partitionSize);
+
+        std::copy (inputWindow.begin(), inputWindow.end(), fftBuffer.begin());
+        std::fill (fftBuffer.begin() + (std::ptrdiff_t) (2 * partitionSize), fftBuffer.end(), 0.0f);
+        forward (delayReal.data() + head * numBins, delayImag.data() + head * numBins);
+
+        std::fill (sumReal.begin(), sumReal.end(), 0.0f);
+        std::fill (sumImag.begin(), sumImag.end(), 0.0f);
+
+        // the newest input spectrum meets the first partition, the one before the second, and so on
+        for (size_t p = 0; p < numPartitions; ++p)
+        {
+            auto slot = (head + numPartitions - p) % numPartitions;
+            multiplyAdd (delayReal.data() + slot * numBins, delayImag.data() + slot * numBins,
+                         irReal.data() + p * numBins, irImag.data() + p * numBins);
+        }
+
+        head = (head + 1) % numPartitions;
+
+        auto* bins = fftBuffer.data();
+
+        for (size_t k = 0; k < numBins; ++k)
+        {
+            bins[2 * k]     = sumReal[k];
+            bins[2 * k + 1] = sumImag[k];
+        }
+
+        fft->performRealOnlyInverseTransform (bins);
+
+        // the first half is the circular wrap-around of overlap-save and is discarded
+        std::copy_n (bins + partitionSize, partitionSize, output);
+    }
+
+private:
+    // transform fftBuffer and split its non-negative bins into real and imaginary arrays.
+    void forward (float* real, float* imag) noexcept
+    {
+        fft->performRealOnlyForwardTransform (fftBuffer.data(), true);
+
+        for (size_t k = 0; k < numBins; ++k)
+        {
+            real[k] = fftBuffer[2 * k];
+            imag[k] = fftBuffer[2 * k + 1];
+        }
+    }
+
+    void multiplyAdd (const float* xr, const float* xi, const float* hr, const float* hi) noexcept
+    {
+        auto* sr = sumReal.data();
+        auto* si = sumImag.data();
+
+        for (size_t k = 0; k < numBins; ++k)
+        {
+            sr[k] += xr[k] * hr[k] - xi[k] * hi[k];
+            si[k] += xr[k] * hi[k] + xi[k] * hr[k];
+        }
+    }
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> fftBuffer, inputWindow;
+    std::vector<float> irReal, irImag, delayReal, delayImag, sumReal, sumImag;
+    size_t partitionSize = 0, numBins = 0, numPartitions = 0, head = 0;
+};
+
+//==============================================================================
+// how ConvolutionReverb cuts up the impulse response.
+enum class ConvolutionPartitioning
+{
+    uniform,        // every partition the size of a block, all on the audio thread
+    nonUniform      // block-sized partitions for the head, larger ones for the tail on a worker thread
+};
+
+//==============================================================================
+// A convolution reverb node for EffectChain, EffectSends or the master bus of FMSynthesizer.
+// The partition size is the maximum block size given to prepare(), rounded up to a power of
+// two; input is gathered until a partition is full and the wet output is read back one
+// partition later, so the latency is one block and any block size can be processed. The FFT
+// plans and the impulse response spectra are made in prepare() and setImpulseResponse(),
+// never in process(). The impulse response is resampled linearly to the sample rate and
+// scaled to unit energy, so white noise comes out at the level it went in; channel ch uses
+// channel ch of the impulse response, or its last channel if it has fewer.
+//
+// With non-uniform partitioning, the default, only the head of the impulse response is
+// convolved on the audio thread, in block-sized partitions. If the response is long enough
+// for it to pay, the rest, the tail, is convolved by a worker thread, in partitions of 32
+// blocks or at most 8192 samples: each time a tail partition of input is complete it is
+// queued as a job and the worker is woken through a RealtimeSemaphore, which takes no lock,
+// and the head is made long enough that the job's output is first needed a whole tail
+// partition later. The worker has that long to run it. In real time the audio thread never
+// waits for a job: one that is late is counted, its part of the tail is left out, and the
+// worker logs it; if the worker has not started it, the tail is fed silence in its place,
+// so the jobs after it stay aligned. Offline (setRealtime (false)) the calling thread runs a
+// late job itself, so the output is the same however the threads are scheduled.
+class ConvolutionReverb
+{
+public:
+    ConvolutionReverb() = default;
+
+    ~ConvolutionReverb()
+    {
+        tailWorker.reset();
+    }
+
+    // keep a copy of the impulse response; if prepared, the partitions are remade at once,
+    // so call this off the audio thread, or swap in a new node made there.
+    void setImpulseResponse (const juce::AudioBuffer<float>& newImpulseResponse, double newSampleRate)
+    {
+        impulseResponse.setSize (newImpulseResponse.getNumChannels(), newImpulseResponse.getNumSamples());
+
+        for (int ch = 0; ch < impulseResponse.getNumChannels(); ++ch)
+            impulseResponse.copyFrom (ch, 0, newImpulseResponse, ch, 0, newImpulseResponse.getNumSamples());
+
+        impulseResponseSampleRate = newSampleRate;
+
+        if (spec.maximumBlockSize > 0)
+            prepare (spec);
+    }
+
+    bool hasImpulseResponse() const noexcept                { return impulseResponse.getNumSamples() > 0; }
+
+    // takes effect at the next prepare().
+    void setPartitioning (ConvolutionPartitioning newValue) noexcept { partitioning = newValue; }
+
+    // false for offline rendering, where a late tail job is run by the thread calling process()
+    // rather than waited for; call it before process() starts.
+    void setRealtime (bool newValue) noexcept               { realtime = newValue; }
+
+    void setWetLevel (float newValue) noexcept              { wetLevel = newValue; }
+    void setDryLevel (float newValue) noexcept              { dryLevel = newValue; }
+
+    // the delay of the wet signal, in samples.
+    int getLatencySamples() const noexcept                  { return (int) partitionSize; }
+
+    // true if the tail is convolved on the worker thread.
+    bool hasTail() const noexcept                           { return ! tailConvolvers.empty(); }
+
+    // how many tail jobs have finished since the last reset(), and how many of them were late
+    // since prepare(): left out in real time, or run by the calling thread offline.
+    int getNumTailJobs() const noexcept                     { return (int) tailDone.load (std::memory_order_relaxed); }
+    int getNumLateTailJobs() const noexcept                 { return lateTailJobs.load (std::memory_order_relaxed); }
+
+    void prepare (const juce::dsp::ProcessSpec& newSpec)
+    {
+        tailWorker.reset();
+
+        spec = newSpec;
+        partitionSize = (size_t) juce::nextPowerOfTwo ((int) juce::jmax ((juce::uint32) 1, spec.maximumBlockSize));
+        tailPartitionSize = juce::jmin ((size_t) 8192, 32 * partitionSize);
+
+        // the output of a tail job is first needed one tail partition after the job is queued
+        auto headLength = 2 * tailPartitionSize - partitionSize;
+
+        // with tail partitions only a few times the block, or a tail not much longer than the
+        // head, the extra FFTs of the tail cost more than the multiply-adds they save
+        auto ir = getScaledImpulseResponse();
+        auto irLength = (size_t) ir.getNumSamples();
+        auto useTail = partitioning == ConvolutionPartitioning::nonUniform
+                        && tailPartitionSize >= 8 * partitionSize && irLength > 4 * headLength;
+
+        convolvers.resize (spec.numChannels);
+        tailConvolvers.resize (useTail ? spec.numChannels : 0);
+        inputPartitions .setSize ((int) spec.numChannels, (int) partitionSize);
+        outputPartitions.setSize ((int) spec.numChannels, (int) partitionSize);
+
+        for (size_t ch = 0; ch < convolvers.size(); ++ch)
+        {
+            auto irChannel = juce::jmin ((int) ch, juce::jmax (0, ir.getNumChannels() - 1));
+            auto* channelData = ir.getNumChannels() > 0 ? ir.getReadPointer (irChannel) : nullptr;
+
+            convolvers[ch].prepare (channelData, useTail ? headLength : irLength, partitionSize);
+
+            if (useTail)
+                tailConvolvers[ch].prepare (channelData + headLength, irLength - headLength, tailPartitionSize);
+        }
+
+        for (auto* buffers : { &tailInputs, &tailOutputs })
+            for (auto& buffer : *buffers)
+                buffer.setSize ((int) spec.numChannels, useTail ? (int) tailPartitionSize : 0);
+
+        lateJobInput.setSize ((int) spec.numChannels, useTail ? (int) tailPartitionSize : 0);
+
+        reset();
+        lateTailJobs.store (0, std::memory_order_relaxed);
+
+        if (useTail)
+        {
+            // a late job is left out of the output in real time, so the worker runs just below
+            // the audio thread rather than at a low priority, where the GUI could starve it
+            tailWorker = std::make_unique<TailWorker> (*this);
+            tailWorker->startThread (9);
+        }
+    }
+
+    void reset() noexcept
+    {
+        // stop the worker from claiming another job and let the one it is running finish
+        auto claimed = (juce::uint32) tailState.exchange (0, std::memory_order_acq_rel);
+
+        while (tailDone.load (std::memory_order_acquire) != claimed)
+            std::this_thread::yield();
+
+        tailDone.store (0, std::memory_order_release);
+        tailSkipped.store (0, std::memory_order_release);
+        isDueTailJobLate = false;
+
+        for (auto& convolver : convolvers)
+            convolver.reset();
+
+        for (auto& convolver : tailConvolvers)
+            convolver.reset();
+
+        inputPartitions.clear();
+        outputPartitions.clear();
+        fill = 0;
+        partitionCount = 0;
+    }
+
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto& inputBlock  = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        auto numSamples  = outputBlock.getNumSamples();
+        auto numChannels = juce::jmin (outputBlock.getNumChannels(), convolvers.size());
+
+        jassert (partitionSize > 0);
+
+        if (context.isBypassed || ! hasImpulseResponse())
+        {
+            if constexpr (ProcessContext::usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        for (size_t start = 0; start < numSamples;)
+        {
+            auto numThisTime = juce::jmin (partitionSize - fill, numSamples - start);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                auto* input   = inputBlock .getChannelPointer (ch) + start;
+                auto* output  = outputBlock.getChannelPointer (ch) + start;
+                auto* pending = inputPartitions .getWritePointer ((int) ch) + fill;
+                auto* wet     = outputPartitions.getReadPointer ((int) ch) + fill;
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                {
+                    pending[i] = input[i];
+                    output[i] = dryLevel * input[i] + wetLevel * wet[i];
+                }
+            }
+
+            fill += numThisTime;
+            start += numThisTime;
+
+            if (fill == partitionSize)
+            {
+                for (size_t ch = 0; ch < convolvers.size(); ++ch)
+                    convolvers[ch].process (inputPartitions.getReadPointer ((int) ch), outputPartitions.getWritePointer ((int) ch));
+
+                if (hasTail())
+                    processTail();
+
+                fill = 0;
+            }
+        }
+    }
+
+private:
+    // at the end of each partition: copy its input into the current tail job, queue the job
+    // once it is full, and add the due part of an earlier job's output to the wet signal.
+    void processTail() noexcept
+    {
+        auto partitionsPerJob = tailPartitionSize / partitionSize;
+        auto job = partitionCount / partitionsPerJob;
+        auto offset = (int) ((partitionCount % partitionsPerJob) * partitionSize);
+
+        for (int ch = 0; ch < inputPartitions.getNumChannels(); ++ch)
+            tailInputs[job % 2].copyFrom (ch, offset, inputPartitions, ch, 0, (int) partitionSize);
+
+        if (++partitionCount % partitionsPerJob == 0)
+        {
+            tailState.fetch_add ((juce::uint64) 1 << 32, std::memory_order_seq_cst);
+            tailWorker->wake();
+        }
+
+        // the output of job j is used from the end of job j + 1's input on
+        if (partitionCount < 2 * partitionsPerJob)
+            return;
+
+        auto dueJob = partitionCount / partitionsPerJob - 2;
+        auto dueOffset = (int) ((partitionCount % partitionsPerJob) * partitionSize);
+
+        if (dueOffset == 0)
+            isDueTailJobLate = ! collectTailJob ((juce::uint32) dueJob);
+
+        if (isDueTailJobLate)
+            return;
+
+        for (int ch = 0; ch < outputPartitions.getNumChannels(); ++ch)
+            outputPartitions.addFrom (ch, 0, tailOutputs[dueJob % 2], ch, dueOffset, (int) partitionSize);
+    }
+
+    // returns true if the output of job is complete. The input of job + 2 goes into this job's
+    // slot from now on, so a job that is late is run here offline; in real time it is counted
+    // and given up on instead, and taken from the worker if it has not claimed it yet.
+    bool collectTailJob (juce::uint32 job) noexcept
+    {
+        if (tailDone.load (std::memory_order_acquire) > job)
+            return true;
+
+        lateTailJobs.fetch_add (1, std::memory_order_relaxed);
+
+        if (realtime)
+        {
+            auto current = tailState.load (std::memory_order_acquire);
+            tailSkipped.store (job + 1, std::memory_order_release);
+
+            // the worker feeds silence in place of a job taken from it, and must not fall further behind
+            if ((juce::uint32) current == job
+                 && tailState.compare_exchange_strong (current, current + 1, std::memory_order_seq_cst))
+                tailWorker->wake();
+
+            return false;
+        }
+
+        while (tailDone.load (std::memory_order_acquire) <= job)
+            if (! runTailJob (lateJobInput))
+                std::this_thread::yield();
+
+        return true;
+    }
+
+    // claim and run the next queued tail job, if the one before it has finished; called by the
+    // worker and, offline, by the thread calling process() when a job is late. Jobs run strictly
+    // in order, as each one adds its input to the frequency-domain delay lines of the tail.
+    // jobInput is where the caller copies the job's input before claiming it: in real time the
+    // audio thread refills the slot of a late job without waiting, and a copy it may have
+    // overwritten is dropped, as the audio thread's claim of the job makes this one fail.
+    bool runTailJob (juce::AudioBuffer<float>& jobInput) noexcept
+    {
+        auto current = tailState.load (std::memory_order_acquire);
+        auto claimed = (juce::uint32) current;
+        auto done = tailDone.load (std::memory_order_acquire);
+
+        // a job given up on before it was claimed; only the worker runs these, with silence
+        if (done < claimed)
+        {
+            if (done >= tailSkipped.load (std::memory_order_acquire))
+                return false;
+
+            jobInput.clear();
+            convolveTailJob (done, jobInput);
+            return true;
+        }
+
+        if (claimed >= (juce::uint32) (current >> 32))
+            return false;
+
+        for (int ch = 0; ch < jobInput.getNumChannels(); ++ch)
+            jobInput.copyFrom (ch, 0, tailInputs[claimed % 2], ch, 0, (int) tailPartitionSize);
+
+        if (! tailState.compare_exchange_strong (current, current + 1, std::memory_order_acq_rel))
+            return false;
+
+        convolveTailJob (claimed, jobInput);
+        return true;
+    }
+
+    void convolveTailJob (juce::uint32 job, const juce::AudioBuffer<float>& input) noexcept
+    {
+        auto& output = tailOutputs[job % 2];
+
+        for (size_t ch = 0; ch < tailConvolvers.size(); ++ch)
+            tailConvolvers[ch].process (input.getReadPointer ((int) ch), output.getWritePointer ((int) ch));
+
+        tailDone.store (job + 1, std::memory_order_release);
+    }
+
+    struct TailWorker   : public juce::Thread
+    {
+        explicit TailWorker (ConvolutionReverb& r)
+            : juce::Thread ("Convolution tail worker"), reverb (r),
+              input (r.lateJobInput.getNumChannels(), r.lateJobInput.getNumSamples())
+        {
+        }
+
+        ~TailWorker() override
+        {
+            signalThreadShouldExit();
+            wake();
+            stopThread (1000);
+        }
+
+        // wake the worker if it is asleep; takes no lock, so the audio thread can call it.
+        void wake() noexcept
+        {
+            if (sleeping.exchange (false))
+                semaphore.signal();
+        }
+
+        // woken by process() as each job is queued; late jobs are logged from here, off the audio thread
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                if (! reverb.runTailJob (input))
+                {
+                    sleeping.store (true);
+
+                    // sequentially consistent with processTail(), so a job queued after the
+                    // check finds the worker asleep and signals it
+                    if (! reverb.hasTailJob() && ! threadShouldExit())
+                        semaphore.wait();
+                    else if (! sleeping.exchange (false))
+                        semaphore.wait();
+                }
+
+                auto numLate = reverb.getNumLateTailJobs();
+
+                if (numLate != numLateLogged)
+                {
+                    juce::Logger::writeToLog ("ConvolutionReverb: " + juce::String (numLate - numLateLogged)
+                                                + " tail job(s) late, " + juce::String (numLate) + " in total");
+                    numLateLogged = numLate;
+                }
+            }
+        }
+
+        ConvolutionReverb& reverb;
+        juce::AudioBuffer<float> input;
+        RealtimeSemaphore semaphore;
+        std::atomic<bool> sleeping { false };
+        int numLateLogged = 0;
+    };
+
+    // true if the worker has a job to run: a queued one, or one given up on to feed silence.
+    bool hasTailJob() const noexcept
+    {
+        auto current = tailState.load();
+        auto claimed = (juce::uint32) current;
+        auto done = tailDone.load();
+        return claimed < (juce::uint32) (current >> 32) || (done < claimed && done < tailSkipped.load());
+    }
+
+    // the impulse response at the sample rate of spec, with unit energy per channel on average.
+    juce::AudioBuffer<float> getScaledImpulseResponse() const
+    {
+        if (! hasImpulseResponse() || spec.sampleRate <= 0.0)
+            return {};
+
+        auto ratio = impulseResponseSampleRate / spec.sampleRate;
+        auto numSamples = juce::jmax (1, (int) std::ceil (impulseResponse.getNumSamples() / ratio));
+        juce::AudioBuffer<float> ir (impulseResponse.getNumChannels(), numSamples);
+        auto energy = 0.0;
+
+        for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+        {
+            auto* source = impulseResponse.getReadPointer (ch);
+            auto* destination = ir.getWritePointer (ch);
+            auto last = impulseResponse.getNumSamples() - 1;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto position = i * ratio;
+                auto index = juce::jmin ((int) position, last);
+                auto frac = (float) (position - index);
+                destination[i] = source[index] + frac * (source[juce::jmin (index + 1, last)] - source[index]);
+                energy += (double) destination[i] * destination[i];
+            }
+        }
+
+        if (energy > 0.0)
+            ir.applyGain ((float) std::sqrt (ir.getNumChannels() / energy));
+
+        return ir;
+    }
+
+    juce::AudioBuffer<float> impulseResponse, inputPartitions, outputPartitions;
+    double impulseResponseSampleRate = 48000.0;
+    juce::dsp::ProcessSpec spec { 0.0, 0, 0 };
+    ConvolutionPartitioning partitioning = ConvolutionPartitioning::nonUniform;
+
+    std::vector<PartitionedConvolver> convolvers;
+    size_t partitionSize = 0, fill = 0;
+    float wetLevel = 0.3f, dryLevel = 1.0f;
+    bool realtime = true;
+
+    // the tail: two job slots, one being filled or run while the other's output is read.
+    // tailState packs the number of queued jobs (upper 32 bits) and claimed jobs (lower 32
+    // bits) into one word, so a claim fails if a reset happened since the state was read.
+    // Jobs below tailSkipped that were claimed but not run were given up on in real time.
+    std::vector<PartitionedConvolver> tailConvolvers;
+    std::array<juce::AudioBuffer<float>, 2> tailInputs, tailOutputs;
+    juce::AudioBuffer<float> lateJobInput;
+    size_t tailPartitionSize = 0, partitionCount = 0;
+    std::atomic<juce::uint64> tailState { 0 };
+    std::atomic<juce::uint32> tailDone { 0 }, tailSkipped { 0 };
+    std::atomic<int> lateTailJobs { 0 };
+    bool isDueTailJobLate = false;
+    std::unique_ptr<TailWorker> tailWorker;
+
+    JUCE_DECLARE_NON_COPYABLE (ConvolutionReverb)
+};
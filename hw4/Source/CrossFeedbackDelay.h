@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    CrossFeedbackDelay.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// A delay of numChannels channels whose delayed outputs are fed back into the inputs through
+// a numChannels x numChannels matrix, so a repeat can move between channels: the default
+// matrix sends each channel to the next, which for two channels is a ping-pong delay, and
+// setIndependent() gives one feedback delay per channel. The past samples are kept in one
+// buffer of interleaved frames, so one cache line holds every channel of a time index, and
+// the channels of a frame are processed together in SIMD lanes: a block is interleaved in
+// chunks, each frame is read, mixed and written as a whole and the chunk is split back into
+// channels. With the same delay on every channel the delayed frame is a single contiguous
+// load, and with a diagonal matrix the feedback is one multiply-add across the lanes. That
+// removes the per-channel loop and its overhead, but every channel still has to be read from
+// the planar input, written to the buffer and written to the planar output, so the cost is
+// linear in the channel count with a roughly constant cost per channel. For the repeats to
+// die away the matrix times the feedback gain must have a norm below one.
+template <typename Type, size_t numChannels>
+class CrossFeedbackDelay
+{
+public:
+    // matrix[row][column] is the gain from the delayed output of channel column into the input of channel row.
+    using Matrix = std::array<std::array<Type, numChannels>, numChannels>;
+
+    static constexpr size_t chunkSize = 32;
+
+    CrossFeedbackDelay()
+    {
+        setPingPong();
+    }
+
+    // make room for at least minimumSize frames; the buffer is rounded up to a power of two and cleared.
+    void resize (size_t minimumSize)
+    {
+        size_t newSize = 1;
+
+        while (newSize < minimumSize)
+            newSize <<= 1;
+
+        frames.assign (newSize * numChannels, Type (0));
+        mask = newSize - 1;
+    }
+
+    // the number of frames in the buffer, a power of two.
+    size_t size() const noexcept                            { return frames.size() / numChannels; }
+
+    void clear() noexcept
+    {
+        std::fill (frames.begin(), frames.end(), Type (0));
+    }
+
+    void setMatrix (const Matrix& newValue) noexcept
+    {
+        diagonal = true;
+
+        for (size_t row = 0; row < numChannels; ++row)
+        {
+            for (size_t column = 0; column < numChannels; ++column)
+            {
+                columns[column][row] = newValue[row][column];
+                diagonal = diagonal && (row == column || newValue[row][column] == Type (0));
+            }
+
+            diagonalGains[row] = newValue[row][row];
+        }
+    }
+
+    // each channel fed back into the next, and the last into the first.
+    void setPingPong() noexcept
+    {
+        Matrix m {};
+
+        for (size_t row = 0; row < numChannels; ++row)
+            m[row][(row + numChannels - 1) % numChannels] = Type (1);
+
+        setMatrix (m);
+    }
+
+    // each channel fed back into itself, as numChannels separate feedback delays.
+    void setIndependent() noexcept
+    {
+        Matrix m {};
+
+        for (size_t row = 0; row < numChannels; ++row)
+            m[row][row] = Type (1);
+
+        setMatrix (m);
+    }
+
+    // write the input, plus the delayed output through the matrix times feedback, and set the
+    // output to the input faded by wetDry into the delayed output. The delays of each channel,
+    // in samples, are faded from fromDelays to toDelays across the block, so that a change
+    // neither clicks nor glides; channels beyond those of the blocks get no input.
+    template <typename InputBlock, typename OutputBlock>
+    void process (const InputBlock& inputBlock, OutputBlock& outputBlock,
+                  const size_t* fromDelays, const size_t* toDelays, Type feedback, Type wetDry) noexcept
+    {
+        std::array<size_t, numChannels> from, to;
+        auto changing = false, uniform = true;
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            from[ch] = juce::jlimit ((size_t) 1, size() - 1, fromDelays[ch]);
+            to[ch]   = juce::jlimit ((size_t) 1, size() - 1, toDelays[ch]);
+            changing = changing || from[ch] != to[ch];
+            uniform  = uniform && to[ch] == to[0];
+        }
+
+        if (changing)
+            processBlock<Reads::crossfaded> (inputBlock, outputBlock, from, to, feedback, wetDry);
+        else if (uniform && diagonal)
+            processBlock<Reads::uniform, true> (inputBlock, outputBlock, from, to, feedback, wetDry);
+        else if (uniform)
+            processBlock<Reads::uniform> (inputBlock, outputBlock, from, to, feedback, wetDry);
+        else
+            processBlock<Reads::perChannel> (inputBlock, outputBlock, from, to, feedback, wetDry);
+    }
+
+private:
+    // how the delayed frame is read: one contiguous frame, one sample per channel, or faded between two delays.
+    enum class Reads { uniform, perChannel, crossfaded };
+
+    using Frame = std::array<Type, numChannels>;
+
+    // the frames are processed with local copies of the buffer pointer and write pointer, so the
+    // compiler can keep them in registers across the stores into the buffer.
+    template <Reads reads, bool isDiagonal = false, typename InputBlock, typename OutputBlock>
+    void processBlock (const InputBlock& inputBlock, OutputBlock& outputBlock,
+                       const std::array<size_t, numChannels>& from, const std::array<size_t, numChannels>& to,
+                       Type feedback, Type wetDry) noexcept
+    {
+        auto numSamples = outputBlock.getNumSamples();
+        auto numBlockChannels = juce::jmin (outputBlock.getNumChannels(), numChannels);
+        auto fadeStep = Type (1) / (Type) juce::jmax ((size_t) 1, numSamples);
+
+        Matrix scaled;
+        Frame gains;
+
+        for (size_t column = 0; column < numChannels; ++column)
+        {
+            for (size_t row = 0; row < numChannels; ++row)
+                scaled[column][row] = feedback * columns[column][row];
+
+            gains[column] = feedback * diagonalGains[column];
+        }
+
+        alignas (64) std::array<Frame, chunkSize> inputFrames, delayedFrames;
+
+        for (auto& frame : inputFrames)
+            frame.fill (Type (0));
+
+        auto* data = frames.data();
+        auto position = writePointer;
+
+        for (size_t start = 0; start < numSamples; start += chunkSize)
+        {
+            auto numThisTime = juce::jmin (chunkSize, numSamples - start);
+
+            for (size_t ch = 0; ch < numBlockChannels; ++ch)
+            {
+                auto* input = inputBlock.getChannelPointer (ch) + start;
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                    inputFrames[i][ch] = input[i];
+            }
+
+            for (size_t i = 0; i < numThisTime; ++i)
+            {
+                auto& delayed = delayedFrames[i];
+                readFrame<reads> (data, position, delayed, from, to, (Type) (start + i + 1) * fadeStep);
+
+                auto mixed = inputFrames[i];
+
+                if constexpr (isDiagonal)
+                {
+                    for (size_t ch = 0; ch < numChannels; ++ch)
+                        mixed[ch] += gains[ch] * delayed[ch];
+                }
+                else
+                {
+                    for (size_t column = 0; column < numChannels; ++column)
+                        for (size_t row = 0; row < numChannels; ++row)
+                            mixed[row] += scaled[column][row] * delayed[column];
+                }
+
+                std::copy (mixed.begin(), mixed.end(), data + (position & mask) * numChannels);
+                ++position;
+            }
+
+            for (size_t ch = 0; ch < numBlockChannels; ++ch)
+            {
+                auto* output = outputBlock.getChannelPointer (ch) + start;
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                    output[i] = inputFrames[i][ch] + wetDry * (delayedFrames[i][ch] - inputFrames[i][ch]);
+            }
+        }
+
+        writePointer = position;
+    }
+
+    template <Reads reads>
+    void readFrame (const Type* data, size_t position, Frame& delayed, const std::array<size_t, numChannels>& from,
+                    const std::array<size_t, numChannels>& to, Type fade) const noexcept
+    {
+        if constexpr (reads == Reads::uniform)
+        {
+            auto* frame = data + ((position - to[0]) & mask) * numChannels;
+            std::copy (frame, frame + numChannels, delayed.begin());
+        }
+        else
+        {
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                delayed[ch] = data[((position - to[ch]) & mask) * numChannels + ch];
+
+                if constexpr (reads == Reads::crossfaded)
+                {
+                    auto old = data[((position - from[ch]) & mask) * numChannels + ch];
+                    delayed[ch] = old + fade * (delayed[ch] - old);
+                }
+            }
+        }
+    }
+
+    std::vector<Type> frames;
+    size_t mask = 0, writePointer = 0;
+    Matrix columns {};
+    Frame diagonalGains {};
+    bool diagonal = false;
+};
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    DelayInterpolation.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// ways of reading a delay line between two samples, e.g. for the modulated taps of a chorus or
+// flanger. The Chorus and Flanger policies in Synth.h are the homework, so nothing in the effect
+// path calls these yet; the DelayLine/taps16 benchmark cases do.
+enum class DelayInterpolation
+{
+    linear,     // 2 points; cheapest, but dulls the highs at half-sample delays
+    lagrange,   // 4-point, 3rd-order Lagrange polynomial
+    hermite,    // 4-point, 3rd-order Hermite (Catmull-Rom) spline
+    allpass     // 2 points and one sample of memory; flat magnitude, best for slowly moving delays
+};
+
+//==============================================================================
+// Interpolation kernels on the samples around a fractional delay. newer is the sample one
+// step more recent than x0, and x1 and older are the next two going back in time, so the
+// wanted value lies between x0 and x1, a fraction frac of the way towards x1.
+template <typename Type>
+struct DelayInterpolator
+{
+    static Type linear (Type x0, Type x1, Type frac) noexcept
+    {
+        return x0 + frac * (x1 - x0);
+    }
+
+    static Type lagrange (Type newer, Type x0, Type x1, Type older, Type frac) noexcept
+    {
+        auto d1 = frac - Type (1), d2 = frac - Type (2), d3 = frac + Type (1);
+        auto c0 = -frac * d1 * d2 * Type (1.0 / 6.0);
+        auto c1 =    d3 * d1 * d2 * Type (0.5);
+        auto c2 = -d3 * frac * d2 * Type (0.5);
+        auto c3 =  d3 * frac * d1 * Type (1.0 / 6.0);
+        return c0 * newer + c1 * x0 + c2 * x1 + c3 * older;
+    }
+
+    static Type hermite (Type newer, Type x0, Type x1, Type older, Type frac) noexcept
+    {
+        auto c1 = Type (0.5) * (x1 - newer);
+        auto c2 = newer - Type (2.5) * x0 + Type (2) * x1 - Type (0.5) * older;
+        auto c3 = Type (0.5) * (older - newer) + Type (1.5) * (x0 - x1);
+        return ((c3 * frac + c2) * frac + c1) * frac + x0;
+    }
+
+    // first-order allpass with coefficient (1 - frac) / (1 + frac); state is the previous output.
+    static Type allpass (Type x0, Type x1, Type frac, Type& state) noexcept
+    {
+        auto alpha = (Type (1) - frac) / (Type (1) + frac);
+        state = x1 + alpha * (x0 - state);
+        return state;
+    }
+};
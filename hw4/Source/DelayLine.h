@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+    DelayLine.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayInterpolation.h"
+
+//==============================================================================
+// Ring buffer of past samples whose length is a power of two, so every index wraps with a
+// mask: read and write pointers can simply be incremented, and a read pointer is the write
+// pointer minus the delay in samples, without any comparisons. Single samples are accessed
+// with get() and push(); blocks are copied with read() and write(), which split the copy at
+// most once, where it crosses the end of the buffer. Fractional delays are read with
+// getInterpolated() and its block forms; the cubic kernels need a delay of at least one
+// sample, as they also use the sample after the wanted position.
+template <typename Type>
+class DelayLine
+{
+public:
+    void clear() noexcept
+    {
+        std::fill (rawData.begin(), rawData.end(), Type (0));
+    }
+
+    // the length of the buffer, a power of two.
+    size_t size() const noexcept
+    {
+        return rawData.size();
+    }
+
+    // make room for at least minimumSize samples; the buffer is rounded up to a power of two and cleared.
+    void resize (size_t minimumSize)
+    {
+        size_t newSize = 1;
+
+        while (newSize < minimumSize)
+            newSize <<= 1;
+
+        rawData.assign (newSize, Type (0));
+        mask = newSize - 1;
+    }
+
+    // the position of any index inside the buffer.
+    size_t wrap (size_t index) const noexcept
+    {
+        return index & mask;
+    }
+
+    Type get (size_t readPointer) const noexcept
+    {
+        return rawData[readPointer & mask];
+    }
+
+    void push (size_t writePointer, Type valueToAdd) noexcept
+    {
+        rawData[writePointer & mask] = valueToAdd;
+    }
+
+    // the samples from position readPointer on, where they are stored; they are contiguous for
+    // getNumContiguous (readPointer) samples, up to the end of the buffer.
+    const Type* getReadPointer (size_t readPointer) const noexcept
+    {
+        return rawData.data() + (readPointer & mask);
+    }
+
+    size_t getNumContiguous (size_t readPointer) const noexcept
+    {
+        return size() - (readPointer & mask);
+    }
+
+    // copy numSamples samples from position readPointer on into destination.
+    void read (size_t readPointer, Type* destination, size_t numSamples) const noexcept
+    {
+        jassert (numSamples <= size());
+        auto start = readPointer & mask;
+        auto numFirst = juce::jmin (numSamples, size() - start);
+
+        std::copy_n (rawData.data() + start, numFirst, destination);
+        std::copy_n (rawData.data(), numSamples - numFirst, destination + numFirst);
+    }
+
+    // copy numSamples samples from source into the buffer from position writePointer on.
+    void write (size_t writePointer, const Type* source, size_t numSamples) noexcept
+    {
+        jassert (numSamples <= size());
+        auto start = writePointer & mask;
+        auto numFirst = juce::jmin (numSamples, size() - start);
+
+        std::copy_n (source, numFirst, rawData.data() + start);
+        std::copy_n (source + numFirst, numSamples - numFirst, rawData.data());
+    }
+
+    // a block read whose delay changes from fromDelay to toDelay: output[i] is the value fromDelay
+    // samples before writePointer + i faded linearly into the value toDelay samples before it.
+    // Unlike a ramped read position this gives no pitch glide; the input up to writePointer +
+    // numSamples - 1 should be written first if either delay is shorter than the block.
+    void readCrossfaded (size_t writePointer, size_t fromDelay, size_t toDelay, Type* output, size_t numSamples) const noexcept
+    {
+        if (fromDelay == toDelay || numSamples == 0)
+        {
+            read (writePointer - fromDelay, output, numSamples);
+            return;
+        }
+
+        auto step = Type (1) / (Type) numSamples;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto from = get (writePointer + i - fromDelay), to = get (writePointer + i - toDelay);
+            output[i] = from + (Type) (i + 1) * step * (to - from);
+        }
+    }
+
+    // the value delay samples before writePointer. allpassState is the memory of the allpass
+    // interpolation, kept by the caller for each tap from one call to the next.
+    template <DelayInterpolation interpolation>
+    Type getInterpolated (size_t writePointer, Type delay, Type* allpassState = nullptr) const noexcept
+    {
+        Neighbours n;
+        gather<interpolation> ((juce::uint32) writePointer, 0, &delay, 1, n);
+
+        if constexpr (interpolation == DelayInterpolation::allpass)
+        {
+            jassert (allpassState != nullptr);
+            return DelayInterpolator<Type>::allpass (n.x0[0], n.x1[0], n.frac[0], *allpassState);
+        }
+        else
+        {
+            juce::ignoreUnused (allpassState);
+            return evaluate<interpolation> (n, 0);
+        }
+    }
+
+    // a block of one tap whose delay changes every sample: output[i] is the value delays[i] samples
+    // before writePointer + i. The input up to writePointer + numSamples - 1 should be written first.
+    template <DelayInterpolation interpolation>
+    void readInterpolated (size_t writePointer, const Type* delays, Type* output, int numSamples,
+                           Type* allpassState = nullptr) const noexcept
+    {
+        for (int start = 0; start < numSamples; start += chunkSize)
+        {
+            auto numThisTime = juce::jmin (chunkSize, numSamples - start);
+            Neighbours n;
+            gather<interpolation> ((juce::uint32) (writePointer + (size_t) start), 1, delays + start, numThisTime, n);
+
+            if constexpr (interpolation == DelayInterpolation::allpass)
+            {
+                // the allpass feeds back on its own output, so a single tap runs sample by sample
+                jassert (allpassState != nullptr);
+
+                for (int i = 0; i < numThisTime; ++i)
+                    output[start + i] = DelayInterpolator<Type>::allpass (n.x0[(size_t) i], n.x1[(size_t) i], n.frac[(size_t) i], *allpassState);
+            }
+            else
+            {
+                juce::ignoreUnused (allpassState);
+
+                for (int i = 0; i < numThisTime; ++i)
+                    output[start + i] = evaluate<interpolation> (n, i);
+            }
+        }
+    }
+
+    // many taps at the same time: outputs[t] is the value delays[t] samples before writePointer.
+    // With the allpass kernel, allpassStates holds the memory of each tap.
+    template <DelayInterpolation interpolation>
+    void readTaps (size_t writePointer, const Type* delays, Type* outputs, int numTaps,
+                   Type* allpassStates = nullptr) const noexcept
+    {
+        for (int start = 0; start < numTaps; start += chunkSize)
+        {
+            auto numThisTime = juce::jmin (chunkSize, numTaps - start);
+            Neighbours n;
+            gather<interpolation> ((juce::uint32) writePointer, 0, delays + start, numThisTime, n);
+
+            if constexpr (interpolation == DelayInterpolation::allpass)
+            {
+                jassert (allpassStates != nullptr);
+                auto* states = allpassStates + start;
+
+                for (int t = 0; t < numThisTime; ++t)
+                    outputs[start + t] = DelayInterpolator<Type>::allpass (n.x0[(size_t) t], n.x1[(size_t) t], n.frac[(size_t) t], states[t]);
+            }
+            else
+            {
+                juce::ignoreUnused (allpassStates);
+
+                for (int t = 0; t < numThisTime; ++t)
+                    outputs[start + t] = evaluate<interpolation> (n, t);
+            }
+        }
+    }
+
+private:
+    // reads are done in chunks: first the samples around each read position are gathered into
+    // arrays on the stack, then the kernel runs over the arrays. The gather is a plain loop of
+    // indexed loads, which the compiler may or may not turn into gather instructions; the
+    // kernels are branch-free loops over arrays that cannot alias the buffer, so they vectorise.
+    static constexpr int chunkSize = 64;
+
+    struct Neighbours
+    {
+        std::array<Type, chunkSize> newer, x0, x1, older, frac;
+    };
+
+    // the samples around numReads delays, read i at position + i * positionStep.
+    template <DelayInterpolation interpolation>
+    void gather (juce::uint32 position, juce::uint32 positionStep, const Type* delays, int numReads, Neighbours& n) const noexcept
+    {
+        constexpr auto isCubic = interpolation == DelayInterpolation::lagrange || interpolation == DelayInterpolation::hermite;
+        std::array<juce::uint32, chunkSize> index;
+
+        for (int i = 0; i < numReads; ++i)
+        {
+            auto delayInt = (juce::int32) delays[i];
+            auto frac = delays[i] - (Type) delayInt;
+
+            if constexpr (interpolation == DelayInterpolation::allpass)
+            {
+                // keep the fraction in [0.618, 1.618), where the allpass delay is most even over frequency
+                auto shift = (frac < Type (0.618) && delayInt >= 1) ? 1 : 0;
+                delayInt -= shift;
+                frac += (Type) shift;
+            }
+
+            n.frac[(size_t) i] = frac;
+            index[(size_t) i] = position + (juce::uint32) i * positionStep - (juce::uint32) delayInt;
+        }
+
+        auto* data = rawData.data();
+        auto wrapMask = (juce::uint32) mask;
+
+        for (int i = 0; i < numReads; ++i)
+        {
+            n.x0[(size_t) i] = data[index[(size_t) i] & wrapMask];
+            n.x1[(size_t) i] = data[(index[(size_t) i] - 1) & wrapMask];
+
+            if constexpr (isCubic)
+            {
+                n.newer[(size_t) i] = data[(index[(size_t) i] + 1) & wrapMask];
+                n.older[(size_t) i] = data[(index[(size_t) i] - 2) & wrapMask];
+            }
+        }
+    }
+
+    template <DelayInterpolation interpolation>
+    static Type evaluate (const Neighbours& n, int i) noexcept
+    {
+        auto k = (size_t) i;
+
+        if constexpr (interpolation == DelayInterpolation::linear)
+            return DelayInterpolator<Type>::linear (n.x0[k], n.x1[k], n.frac[k]);
+        else if constexpr (interpolation == DelayInterpolation::lagrange)
+            return DelayInterpolator<Type>::lagrange (n.newer[k], n.x0[k], n.x1[k], n.older[k], n.frac[k]);
+        else
+            return DelayInterpolator<Type>::hermite (n.newer[k], n.x0[k], n.x1[k], n.older[k], n.frac[k]);
+    }
+
+    std::vector<Type> rawData { Type (0) };
+    size_t mask = 0;
+};
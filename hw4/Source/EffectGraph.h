@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    EffectGraph.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// Effects wired into a graph whose shape is fixed at compile time. A node is anything with
+// prepare (ProcessSpec), reset() and process (ProcessContext), such as Effect; EffectChain
+// and EffectSends are nodes too, so they nest, e.g. a delay, then chorus and flanger sent
+// in parallel: EffectChain<Effect<float>, EffectSends<float, Effect<float>, Effect<float>>>.
+// Every buffer is allocated in prepare(), so process() never allocates or locks.
+
+// nodes in series, each processing the output of the one before in place.
+template <typename... Nodes>
+class EffectChain
+{
+public:
+    template <size_t index>
+    auto& get() noexcept                                    { return std::get<index> (nodes); }
+
+    void prepare (const juce::dsp::ProcessSpec& spec)
+    {
+        std::apply ([&] (auto&... node) { (node.prepare (spec), ...); }, nodes);
+    }
+
+    void reset() noexcept
+    {
+        std::apply ([] (auto&... node) { (node.reset(), ...); }, nodes);
+    }
+
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        using SampleType = typename ProcessContext::SampleType;
+        auto& outputBlock = context.getOutputBlock();
+
+        if constexpr (ProcessContext::usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom (context.getInputBlock());
+
+        if (context.isBypassed)
+            return;
+
+        auto replacing = juce::dsp::ProcessContextReplacing<SampleType> (outputBlock);
+        std::apply ([&] (auto&... node) { (node.process (replacing), ...); }, nodes);
+    }
+
+private:
+    std::tuple<Nodes...> nodes;
+};
+
+//==============================================================================
+// nodes in parallel, each fed its own copy of the input; the output is the input times the
+// dry level plus each node's output times its send level. Blocks longer than the maximum
+// block size given to prepare() are processed in parts. The send buffers are allocated in
+// prepare(), so unlike EffectChain the sample type is given up front, e.g. double for
+// EffectSends<double, Effect<double>, Effect<double>>.
+template <typename SampleType, typename... Nodes>
+class EffectSends
+{
+public:
+    static constexpr size_t numSends = sizeof... (Nodes);
+
+    EffectSends()
+    {
+        sendLevels.fill (SampleType (1));
+    }
+
+    template <size_t index>
+    auto& get() noexcept                                    { return std::get<index> (nodes); }
+
+    void setDryLevel (SampleType newValue) noexcept         { dryLevel = newValue; }
+    void setSendLevel (size_t index, SampleType newValue) noexcept
+    {
+        jassert (index < numSends);
+        sendLevels[index] = newValue;
+    }
+
+    void prepare (const juce::dsp::ProcessSpec& spec)
+    {
+        for (auto& buffer : sendBuffers)
+            buffer.setSize ((int) spec.numChannels, (int) spec.maximumBlockSize);
+
+        maxBlockSize = (size_t) spec.maximumBlockSize;
+        std::apply ([&] (auto&... node) { (node.prepare (spec), ...); }, nodes);
+    }
+
+    void reset() noexcept
+    {
+        std::apply ([] (auto&... node) { (node.reset(), ...); }, nodes);
+    }
+
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, SampleType>,
+                       "EffectSends must process the sample type it was declared with");
+
+        auto& inputBlock  = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        auto numSamples = outputBlock.getNumSamples();
+
+        jassert (maxBlockSize > 0 && outputBlock.getNumChannels() <= (size_t) sendBuffers[0].getNumChannels());
+
+        if (context.isBypassed)
+        {
+            if constexpr (ProcessContext::usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        for (size_t start = 0; start < numSamples; start += maxBlockSize)
+        {
+            auto numThisTime = juce::jmin (maxBlockSize, numSamples - start);
+            auto input  = inputBlock .getSubBlock (start, numThisTime);
+            auto output = outputBlock.getSubBlock (start, numThisTime);
+
+            // the sends take their copies before the output, which may be the input, is written
+            size_t index = 0;
+            std::apply ([&] (auto&... node) { (processSend (node, index++, input), ...); }, nodes);
+
+            if constexpr (ProcessContext::usesSeparateInputAndOutputBlocks())
+                output.copyFrom (input);
+
+            output.multiplyBy (dryLevel);
+
+            for (size_t i = 0; i < numSends; ++i)
+                output.addProductOf (getSendBlock (i, output.getNumChannels(), numThisTime), sendLevels[i]);
+        }
+    }
+
+private:
+    juce::dsp::AudioBlock<SampleType> getSendBlock (size_t index, size_t numChannels, size_t numSamples)
+    {
+        return juce::dsp::AudioBlock<SampleType> (sendBuffers[index]).getSubsetChannelBlock (0, numChannels)
+                                                                     .getSubBlock (0, numSamples);
+    }
+
+    template <typename Node, typename Block>
+    void processSend (Node& node, size_t index, const Block& input) noexcept
+    {
+        auto block = getSendBlock (index, input.getNumChannels(), input.getNumSamples());
+        block.copyFrom (input);
+        node.process (juce::dsp::ProcessContextReplacing<SampleType> (block));
+    }
+
+    std::tuple<Nodes...> nodes;
+    std::array<juce::AudioBuffer<SampleType>, numSends> sendBuffers;
+    std::array<SampleType, numSends> sendLevels;
+    SampleType dryLevel = SampleType (1);
+    size_t maxBlockSize = 0;
+};
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    Envelope.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// stage times in seconds and the sustain level of an ADSR envelope.
+struct ADSRTimes
+{
+    float attackTime   = 0.0f;
+    float decayTime    = 0.01f;
+    float sustainLevel = 1.0f;
+    float releaseTime  = 0.01f;
+};
+
+//==============================================================================
+// ADSR envelope as a state machine. Every stage is an affine step per sample,
+// level = level * multiplier + offset, whose length in samples is worked out when the
+// stage starts; no per-sample time comparisons or exp/pow calls are needed. The attack
+// is a linear ramp, decay and release are exponential curves that reach their target
+// at -60 dB of the starting distance and then snap to it.
+class ADSREnvelope
+{
+public:
+    enum Stage { attack, decay, sustain, release, idle };
+
+    struct Segment
+    {
+        int numSamples;     // until the next stage; sustain and idle never end by themselves
+        float multiplier, offset, target;
+    };
+
+    // the segment that starts at the given level, skipping stages of zero length.
+    static Segment makeSegment (int& stage, float& level, const ADSRTimes& times, double sampleRate) noexcept
+    {
+        for (;;)
+        {
+            if (stage == sustain || stage == idle)
+            {
+                level = (stage == sustain ? times.sustainLevel : 0.0f);
+                return { std::numeric_limits<int>::max(), 1.0f, 0.0f, level };
+            }
+
+            auto time   = stage == attack ? times.attackTime : (stage == decay ? times.decayTime : times.releaseTime);
+            auto target = stage == attack ? 1.0f : (stage == decay ? times.sustainLevel : 0.0f);
+            auto numSamples = (int) std::lround (time * sampleRate);
+
+            if (numSamples > 0)
+            {
+                if (stage == attack)
+                    return { numSamples, 1.0f, (target - level) / (float) numSamples, target };
+
+                auto multiplier = (float) std::pow (0.001, 1.0 / numSamples);
+                return { numSamples, multiplier, target * (1.0f - multiplier), target };
+            }
+
+            level = target;
+            stage = (stage == release ? idle : stage + 1);
+        }
+    }
+
+    void setSampleRate (double newSampleRate) noexcept      { sampleRate = newSampleRate; }
+
+    // the times take effect from the next stage change.
+    void setTimes (const ADSRTimes& newTimes) noexcept      { times = newTimes; }
+
+    void noteOn() noexcept
+    {
+        level = 0.0f;
+        enterStage (attack);
+    }
+
+    void noteOff() noexcept
+    {
+        if (stage != idle && stage != release)
+            enterStage (release);
+    }
+
+    void reset() noexcept
+    {
+        level = 0.0f;
+        enterStage (idle);
+    }
+
+    bool isActive() const noexcept                          { return stage != idle; }
+    bool isAttacking() const noexcept                       { return stage == attack; }
+    bool isReleasing() const noexcept                       { return stage == release; }
+    float getLevel() const noexcept                         { return level; }
+
+    // the current level, then advance by one sample.
+    float getNextSample() noexcept
+    {
+        auto current = level;
+        level = level * segment.multiplier + segment.offset;
+
+        if (--samplesLeft == 0)
+            finishStage();
+
+        return current;
+    }
+
+    // the next numSamples levels, equal within rounding to what numSamples calls to getNextSample()
+    // would return: linear stages use the closed form level + i * offset rather than adding the
+    // offset once per sample, so the two can differ in the last bits.
+    void getNextBlock (float* output, int numSamples) noexcept
+    {
+        while (numSamples > 0)
+        {
+            auto numThisTime = juce::jmin (numSamples, samplesLeft);
+
+            if (segment.multiplier == 1.0f)
+            {
+                // linear and constant stages have a closed form, so the loop vectorises; constant
+                // stages come out exactly, linear ones within rounding
+                for (int i = 0; i < numThisTime; ++i)
+                    output[i] = level + (float) i * segment.offset;
+
+                level += (float) numThisTime * segment.offset;
+            }
+            else
+            {
+                for (int i = 0; i < numThisTime; ++i)
+                {
+                    output[i] = level;
+                    level = level * segment.multiplier + segment.offset;
+                }
+            }
+
+            output     += numThisTime;
+            numSamples -= numThisTime;
+            samplesLeft -= numThisTime;
+
+            if (samplesLeft == 0)
+                finishStage();
+        }
+    }
+
+private:
+    void enterStage (int newStage) noexcept
+    {
+        stage = newStage;
+        segment = makeSegment (stage, level, times, sampleRate);
+        samplesLeft = segment.numSamples;
+    }
+
+    void finishStage() noexcept
+    {
+        if (stage == sustain || stage == idle)
+        {
+            samplesLeft = segment.numSamples;
+            return;
+        }
+
+        level = segment.target;
+        enterStage (stage + 1);
+    }
+
+    ADSRTimes times;
+    Segment segment { std::numeric_limits<int>::max(), 1.0f, 0.0f, 0.0f };
+    double sampleRate = 48000.0;
+    float level = 0.0f;
+    int stage = idle, samplesLeft = std::numeric_limits<int>::max();
+};
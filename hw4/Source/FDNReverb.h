@@ -0,0 +1,350 @@
+/*
+  ==============================================================================
+
+    FDNReverb.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayLine.h"
+
+//==============================================================================
+// An algorithmic reverb: a feedback delay network of numLines DelayLines of mutually prime
+// lengths, whose outputs are damped, mixed by a Hadamard matrix and fed back with the input
+// into the lines. Line l takes the input of channel l % numChannels and feeds its output, with
+// alternating signs, back to that channel, so a stereo input spreads across every line. Each
+// line has a gain set by its length and the decay time, so every line dies away at the same
+// rate, and a one-pole lowpass, so high frequencies die away faster as in a real room. The
+// default of 8 lines is the size meant to cost about one FMVoice per channel; 16 lines cost
+// about three times as much.
+//
+// The lines are processed in chunks no longer than the shortest line, so a chunk of every
+// line can be read where it is stored and written back as a whole block with DelayLine::write;
+// at 256 samples a chunk the passes over the lines cost far more than the calls that start
+// them, so every step works on the chunks in place and as few passes are made as possible.
+// The wet output is summed from the chunks first; the lowpass of each line, with its gain
+// folded into its coefficient, is recursive in time, so it runs sample by sample with the
+// lines interleaved for parallelism; the Hadamard matrix is applied as a fast Walsh-Hadamard
+// transform, sums and differences between whole chunks of lines, which the compiler vectorises
+// across the samples of the chunk, and its last stage adds the input to each line.
+template <typename Type, size_t numLines = 8>
+class FDNReverb
+{
+public:
+    static_assert (numLines >= 2 && (numLines & (numLines - 1)) == 0, "The Hadamard matrix needs a power of two lines");
+
+    static constexpr size_t chunkSize = 256;
+
+    // the reverb time to -60 dB, in seconds.
+    void setDecayTime (Type newValue) noexcept
+    {
+        decayTime = juce::jmax (Type (0.01), newValue);
+        updateGains();
+    }
+
+    // 0 keeps high frequencies as long as low ones, values towards 1 make them die away faster.
+    void setDamping (Type newValue) noexcept
+    {
+        damping = juce::jlimit (Type (0), Type (0.99), newValue);
+        updateCoefficients();
+    }
+
+    // scales the line lengths, between 0.25 and 2; takes effect at the next prepare().
+    void setSize (Type newValue) noexcept                   { size = juce::jlimit (Type (0.25), Type (2), newValue); }
+
+    void setWetLevel (Type newValue) noexcept               { wetLevel = newValue; }
+    void setDryLevel (Type newValue) noexcept               { dryLevel = newValue; }
+
+    void prepare (const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+
+        // line lengths spread exponentially from 25 to 85 ms, each rounded to a prime
+        for (size_t l = 0; l < numLines; ++l)
+        {
+            auto ms = 25.0 * std::pow (85.0 / 25.0, (double) l / (double) (numLines - 1)) * (double) size;
+            delays[l] = nextPrime (juce::jmax ((size_t) chunkSize + 1, (size_t) std::lround (ms * 0.001 * sampleRate)));
+            lines[l].resize (delays[l] + chunkSize);
+        }
+
+        updateGains();
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& line : lines)
+            line.clear();
+
+        filterStates.fill (Type (0));
+        writePointer = 0;
+    }
+
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto& inputBlock  = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        auto numSamples  = outputBlock.getNumSamples();
+        auto numChannels = juce::jmin (outputBlock.getNumChannels(), numLines);
+
+        if (context.isBypassed || numChannels == 0)
+        {
+            if constexpr (ProcessContext::usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        // the Hadamard matrix is scaled to keep the energy of the lines, and the input and
+        // output are scaled so the wet signal is about as loud as the dry
+        auto inputGain  = Type (1) / std::sqrt ((Type) numLines / (Type) numChannels);
+        auto outputGain = inputGain;
+
+        // line l takes channel l % numChannels, with its sign alternating in each round of channels
+        std::array<Type, numLines> signedInputGains, signedOutputGains;
+
+        for (size_t l = 0; l < numLines; ++l)
+        {
+            auto sign = (l / numChannels) % 2 == 0 ? Type (1) : Type (-1);
+            signedInputGains[l]  = sign * inputGain;
+            signedOutputGains[l] = sign * outputGain * wetLevel;
+        }
+
+        for (size_t start = 0; start < numSamples;)
+        {
+            // the outputs of the lines are read where they are stored, so a chunk ends where
+            // any of them reaches the end of its buffer
+            auto numThisTime = juce::jmin (chunkSize, numSamples - start);
+            std::array<const Type*, numLines> delayed;
+
+            for (size_t l = 0; l < numLines; ++l)
+            {
+                delayed[l] = lines[l].getReadPointer (writePointer - delays[l]);
+                numThisTime = juce::jmin (numThisTime, lines[l].getNumContiguous (writePointer - delays[l]));
+            }
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                auto* wet = wetOutputs[ch].data();
+                auto* first = delayed[ch];
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                    wet[i] = signedOutputGains[ch] * first[i];
+
+                for (size_t l = ch + numChannels; l < numLines; l += numChannels)
+                {
+                    auto* lineOutput = delayed[l];
+
+                    for (size_t i = 0; i < numThisTime; ++i)
+                        wet[i] += signedOutputGains[l] * lineOutput[i];
+                }
+            }
+
+            std::array<const Type*, numLines> inputs;
+
+            for (size_t l = 0; l < numLines; ++l)
+                inputs[l] = inputBlock.getChannelPointer (l % numChannels) + start;
+
+            damp (delayed, numThisTime);
+            hadamard (inputs, signedInputGains, numThisTime);
+
+            for (size_t l = 0; l < numLines; ++l)
+                lines[l].write (writePointer, lineOutputs[l].data(), numThisTime);
+
+            // the output is written last, as it may be the input
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                auto* input  = inputBlock .getChannelPointer (ch) + start;
+                auto* output = outputBlock.getChannelPointer (ch) + start;
+                auto* wet = wetOutputs[ch].data();
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                    output[i] = dryLevel * input[i] + wet[i];
+            }
+
+            writePointer += numThisTime;
+            start += numThisTime;
+        }
+    }
+
+private:
+    // the one-pole lowpass and decay gain of every line, from its delayed output into lineOutputs.
+    // The gain is folded into the coefficient of the input, so the states hold the lowpass output
+    // times the gain and each sample of each line costs a single multiply-add. Up to eight lines
+    // are filtered together, which keeps their states and pointers in registers.
+    void damp (const std::array<const Type*, numLines>& delayed, size_t numSamples) noexcept
+    {
+        constexpr size_t groupSize = numLines < 8 ? numLines : 8;
+        auto d = damping;
+
+        for (size_t first = 0; first < numLines; first += groupSize)
+        {
+            std::array<Type, groupSize> states;
+            std::copy_n (filterStates.begin() + (std::ptrdiff_t) first, groupSize, states.begin());
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                for (size_t k = 0; k < groupSize; ++k)
+                {
+                    states[k] = coefficients[first + k] * delayed[first + k][i] + d * states[k];
+                    lineOutputs[first + k][i] = states[k];
+                }
+            }
+
+            std::copy (states.begin(), states.end(), filterStates.begin() + (std::ptrdiff_t) first);
+        }
+    }
+
+    // the fast Walsh-Hadamard transform of lineOutputs, across the lines, for every sample, with
+    // the input times its gain added to each line by the last stage. The first three stages are
+    // done together on groups of up to eight lines held in registers, so up to eight lines take
+    // a single pass over the chunks; each further stage is one more pass.
+    void hadamard (const std::array<const Type*, numLines>& inputs, const std::array<Type, numLines>& inputGains,
+                   size_t numSamples) noexcept
+    {
+        constexpr size_t groupSize = numLines < 8 ? numLines : 8;
+
+        for (size_t first = 0; first < numLines; first += groupSize)
+            transformGroup<groupSize, groupSize == numLines> (first, inputs, inputGains, numSamples);
+
+        for (size_t span = groupSize; span < numLines; span <<= 1)
+        {
+            auto isLastStage = 2 * span == numLines;
+
+            for (size_t first = 0; first < numLines; first += 2 * span)
+            {
+                for (size_t l = first; l < first + span; ++l)
+                {
+                    auto* a = lineOutputs[l].data();
+                    auto* b = lineOutputs[l + span].data();
+
+                    if (isLastStage)
+                    {
+                        auto* inputA = inputs[l];
+                        auto* inputB = inputs[l + span];
+                        auto gainA = inputGains[l], gainB = inputGains[l + span];
+
+                        for (size_t i = 0; i < numSamples; ++i)
+                        {
+                            auto x = a[i], y = b[i];
+                            a[i] = x + y + gainA * inputA[i];
+                            b[i] = x - y + gainB * inputB[i];
+                        }
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < numSamples; ++i)
+                        {
+                            auto x = a[i], y = b[i];
+                            a[i] = x + y;
+                            b[i] = x - y;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // every stage of the transform within the groupSize lines from first on, in one pass.
+    template <size_t groupSize, bool addInput>
+    void transformGroup (size_t first, const std::array<const Type*, numLines>& inputs,
+                         const std::array<Type, numLines>& inputGains, size_t numSamples) noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            std::array<Type, groupSize> v;
+
+            for (size_t k = 0; k < groupSize; ++k)
+                v[k] = lineOutputs[first + k][i];
+
+            // written out stage by stage, as the compiler vectorises straight-line code across i
+            butterfly (v[0], v[1]);
+
+            if constexpr (groupSize >= 4)
+            {
+                butterfly (v[2], v[3]);
+                butterfly (v[0], v[2]);
+                butterfly (v[1], v[3]);
+            }
+
+            if constexpr (groupSize >= 8)
+            {
+                butterfly (v[4], v[5]);
+                butterfly (v[6], v[7]);
+                butterfly (v[4], v[6]);
+                butterfly (v[5], v[7]);
+                butterfly (v[0], v[4]);
+                butterfly (v[1], v[5]);
+                butterfly (v[2], v[6]);
+                butterfly (v[3], v[7]);
+            }
+
+            for (size_t k = 0; k < groupSize; ++k)
+                lineOutputs[first + k][i] = addInput ? v[k] + inputGains[first + k] * inputs[first + k][i] : v[k];
+        }
+    }
+
+    static void butterfly (Type& a, Type& b) noexcept
+    {
+        auto sum = a + b;
+        b = a - b;
+        a = sum;
+    }
+
+    // the gain of each line for a decay of 60 dB in decayTime, with the 1 / sqrt (numLines)
+    // that makes the Hadamard matrix orthogonal folded in.
+    void updateGains() noexcept
+    {
+        auto scale = Type (1) / std::sqrt ((Type) numLines);
+
+        for (size_t l = 0; l < numLines; ++l)
+        {
+            auto newGain = scale * (Type) std::pow (10.0, -3.0 * (double) delays[l] / ((double) decayTime * sampleRate));
+
+            // the states hold the lowpass output times the gain, so they follow it
+            if (gains[l] != Type (0))
+                filterStates[l] *= newGain / gains[l];
+
+            gains[l] = newGain;
+        }
+
+        updateCoefficients();
+    }
+
+    void updateCoefficients() noexcept
+    {
+        for (size_t l = 0; l < numLines; ++l)
+            coefficients[l] = gains[l] * (Type (1) - damping);
+    }
+
+    static size_t nextPrime (size_t n) noexcept
+    {
+        for (;; ++n)
+        {
+            auto isPrime = n > 1;
+
+            for (size_t d = 2; d * d <= n && isPrime; ++d)
+                isPrime = n % d != 0;
+
+            if (isPrime)
+                return n;
+        }
+    }
+
+    std::array<DelayLine<Type>, numLines> lines;
+    std::array<size_t, numLines> delays {};
+    std::array<Type, numLines> gains {}, coefficients {}, filterStates {};
+    size_t writePointer = 0;
+
+    // a chunk of every line, read, damped, mixed and written back in place, and of every wet channel
+    std::array<std::array<Type, chunkSize>, numLines> lineOutputs, wetOutputs;
+
+    double sampleRate = 48000.0;
+    Type decayTime { Type (2) }, damping { Type (0.3) }, size { Type (1) };
+    Type wetLevel { Type (0.3) }, dryLevel { Type (1) };
+};
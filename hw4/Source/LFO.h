@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    LFO.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Oscillator.h"
+
+//==============================================================================
+enum class LFOShape
+{
+    sine,           // sineOfPhase, the polynomial of the voice renderer
+    triangle,       // starts at 0 and rises, like the sine
+    randomSmooth    // a random value per cycle, eased into the next with a smoothstep
+};
+
+//==============================================================================
+// Low-frequency oscillators for up to maxNumOutputs channels or taps that share one rate and
+// shape but each have a phase offset of their own. generate() computes a whole block for every
+// output at once from a single phase accumulator, with branch-free loops over the block that
+// the compiler vectorises, so an output costs a few multiply-adds per sample rather than a
+// std::sin call; the LFO benchmark cases report both. The phase is fixed point with the cycle
+// count in the upper 32 bits and the phase within the cycle, as in Phasor, in the lower 32
+// bits; the random shape hashes the cycle count, so it needs no state and repeats exactly
+// after a reset.
+template <size_t maxNumOutputs>
+class LFOBank
+{
+public:
+    // allocate room for blocks of up to maxBlockSize samples.
+    void prepare (double newSampleRate, size_t newMaxBlockSize)
+    {
+        maxBlockSize = newMaxBlockSize;
+        phases.assign (maxBlockSize, 0);
+        outputs.assign (maxNumOutputs * maxBlockSize, 0.0f);
+        setSampleRate (newSampleRate);
+    }
+
+    void reset() noexcept                                   { phase = 0; }
+
+    size_t getMaxBlockSize() const noexcept                 { return maxBlockSize; }
+
+    void setSampleRate (double newValue) noexcept
+    {
+        sampleRate = newValue;
+        setFrequency (frequency);
+    }
+
+    double getSampleRate() const noexcept                   { return sampleRate; }
+
+    void setFrequency (double hz) noexcept
+    {
+        frequency = hz;
+        increment = (juce::uint64) std::llround (juce::jmax (0.0, hz / sampleRate) * Phasor::phasePerCycle);
+    }
+
+    void setShape (LFOShape newValue) noexcept              { shape = newValue; }
+    LFOShape getShape() const noexcept                      { return shape; }
+
+    // only the first numOutputs outputs are generated.
+    void setNumOutputs (size_t newValue) noexcept
+    {
+        jassert (newValue <= maxNumOutputs);
+        numOutputs = juce::jmin (newValue, maxNumOutputs);
+    }
+
+    // the phase of an output ahead of the others, in cycles; e.g. 0.25 puts a second channel a quarter cycle ahead.
+    void setPhaseOffset (size_t output, double cycles) noexcept
+    {
+        jassert (output < maxNumOutputs);
+        offsets[output] = (juce::uint64) Phasor::cyclesToPhase (cycles);
+    }
+
+    // fill the next numSamples values of every output, in [-1, 1], and advance the phase.
+    void generate (size_t numSamples) noexcept
+    {
+        jassert (numSamples <= maxBlockSize);
+        numSamples = juce::jmin (numSamples, maxBlockSize);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            phases[i] = phase + (juce::uint64) i * increment;
+
+        phase += (juce::uint64) numSamples * increment;
+
+        for (size_t out = 0; out < numOutputs; ++out)
+        {
+            auto* output = outputs.data() + out * maxBlockSize;
+
+            switch (shape)
+            {
+                case LFOShape::sine:            generateSine         (output, offsets[out], numSamples); break;
+                case LFOShape::triangle:        generateTriangle     (output, offsets[out], numSamples); break;
+                case LFOShape::randomSmooth:
+                default:                        generateRandomSmooth (output, offsets[out], numSamples); break;
+            }
+        }
+    }
+
+    // the values of an output from the last call to generate().
+    const float* getOutput (size_t output) const noexcept
+    {
+        jassert (output < numOutputs);
+        return outputs.data() + output * maxBlockSize;
+    }
+
+private:
+    void generateSine (float* output, juce::uint64 offset, size_t numSamples) const noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = sineOfPhase ((juce::uint32) (phases[i] + offset));
+    }
+
+    void generateTriangle (float* output, juce::uint64 offset, size_t numSamples) const noexcept
+    {
+        // the phase as a signed fraction of a cycle folded onto [-0.25, 0.25], as in sineOfPhase
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto x = (float) (juce::int32) (juce::uint32) (phases[i] + offset) * (float) (1.0 / Phasor::phasePerCycle);
+            output[i] = 4.0f * std::copysign (0.25f - std::abs (std::abs (x) - 0.25f), x);
+        }
+    }
+
+    void generateRandomSmooth (float* output, juce::uint64 offset, size_t numSamples) const noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto p = phases[i] + offset;
+            auto cycle = (juce::uint32) (p >> 32);
+            auto t = (float) (juce::int32) ((juce::uint32) p >> 8) * (1.0f / 16777216.0f);   // top 24 bits, a signed conversion
+
+            auto a = randomOfCycle (cycle), b = randomOfCycle (cycle + 1);
+            output[i] = a + t * t * (3.0f - 2.0f * t) * (b - a);
+        }
+    }
+
+    // a value in [-1, 1) hashed from a cycle count.
+    static float randomOfCycle (juce::uint32 cycle) noexcept
+    {
+        auto x = (cycle + 0x6a09e667u) * 0x9e3779b1u;
+        x ^= x >> 16;
+        x *= 0x85ebca6bu;
+        x ^= x >> 13;
+        return (float) (juce::int32) x * (float) (1.0 / 2147483648.0);
+    }
+
+    std::vector<juce::uint64> phases;
+    std::vector<float> outputs;
+    std::array<juce::uint64, maxNumOutputs> offsets {};
+    size_t maxBlockSize = 0, numOutputs = maxNumOutputs;
+
+    juce::uint64 phase = 0, increment = 0;
+    double sampleRate = 48000.0, frequency = 0.0;
+    LFOShape shape = LFOShape::sine;
+};
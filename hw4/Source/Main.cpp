@@ -9,7 +9,7 @@
 */
 
 #include <JuceHeader.h>
-#include "Synth.h"
+#include "MainComponent.h"
 
 class Application   : public juce::JUCEApplication
 {
@@ -0,0 +1,439 @@
+/*
+  ==============================================================================
+
+    MainComponent.h
+    Created: May, 2022
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Synth.h"
+#include "SpectrogramComponent.h"
+
+//==============================================================================
+class MainContentComponent   : public juce::AudioAppComponent,
+                               private juce::Timer
+{
+public:
+    void loadPreset(juce::String name)
+    {
+        setFMParameters (getFMPreset (name));
+    }
+
+    void setFMParameters (const FMParameters& p)
+    {
+        carrierAmplitudeSlider.setValue (p.carrierAmplitude, juce::dontSendNotification);
+        carrierAttackTimeSlider.setValue (p.carrierAttackTime, juce::dontSendNotification);
+        carrierDecayTimeSlider.setValue (p.carrierDecayTime, juce::dontSendNotification);
+        carrierSustainLevelSlider.setValue (p.carrierSustainLevel, juce::dontSendNotification);
+        carrierReleaseTimeSlider.setValue (p.carrierReleaseTime, juce::dontSendNotification);
+        synthAudioSource.setCarrierAmplitude(carrierAmplitudeSlider.getValue());
+        synthAudioSource.setCarrierAttackTime(carrierAttackTimeSlider.getValue());
+        synthAudioSource.setCarrierDecayTime(carrierDecayTimeSlider.getValue());
+        synthAudioSource.setCarrierSustainLevel(carrierSustainLevelSlider.getValue());
+        synthAudioSource.setCarrierReleaseTime(carrierReleaseTimeSlider.getValue());
+        
+        modulatorAmplitudeSlider.setValue (p.modulatorAmplitude, juce::dontSendNotification);
+        modulatorFreqRatioSlider.setValue (p.modulatorFreqRatio, juce::dontSendNotification);
+        modulatorAttackTimeSlider.setValue (p.modulatorAttackTime, juce::dontSendNotification);
+        modulatorDecayTimeSlider.setValue (p.modulatorDecayTime, juce::dontSendNotification);
+        modulatorSustainLevelSlider.setValue (p.modulatorSustainLevel, juce::dontSendNotification);
+        modulatorReleaseTimeSlider.setValue (p.modulatorReleaseTime, juce::dontSendNotification);
+        synthAudioSource.setModulatorAmplitude(modulatorAmplitudeSlider.getValue());
+        synthAudioSource.setModulatorFreqRatio(modulatorFreqRatioSlider.getValue());
+        synthAudioSource.setModulatorAttackTime(modulatorAttackTimeSlider.getValue());
+        synthAudioSource.setModulatorDecayTime(modulatorDecayTimeSlider.getValue());
+        synthAudioSource.setModulatorSustainLevel(modulatorSustainLevelSlider.getValue());
+        synthAudioSource.setModulatorReleaseTime(modulatorReleaseTimeSlider.getValue());
+    }
+
+    void loadFX(juce::String name)
+    {
+        auto p = getFXPreset (name);
+        auto isDelay = (name == "Delay" || name == "CrossFeedback");
+        auto isModulated = (name == "Chorus" || name == "Flanger");
+        auto isMultiTap = (name == "MultiTap");
+
+        feedbackSlider.setEnabled(isDelay);
+        delayTimeSlider.setEnabled(isDelay || isModulated);
+        wetDrySlider.setEnabled(isDelay || isModulated || isMultiTap);
+        LFORateSlider.setEnabled(isModulated);
+        LFODepthSlider.setEnabled(isModulated);
+
+        synthAudioSource.setFXType(name);
+        synthAudioSource.setFXParameters(p);
+
+        feedbackSlider.setValue (p.feedback, juce::dontSendNotification); 
+        delayTimeSlider.setValue (p.delayTime, juce::dontSendNotification); 
+        wetDrySlider.setValue (p.wetDry, juce::dontSendNotification); 
+        LFORateSlider.setValue (p.LFORate, juce::dontSendNotification); 
+        LFODepthSlider.setValue (p.LFODepth, juce::dontSendNotification); 
+    }
+
+    MainContentComponent()
+        : synthAudioSource  (keyboardState),
+          keyboardComponent (keyboardState, juce::MidiKeyboardComponent::horizontalKeyboard)
+    {
+        synthAudioSource.setSampleRate();
+
+        addAndMakeVisible (carrierAmplitudeSlider);
+        carrierAmplitudeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        carrierAmplitudeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        carrierAmplitudeSlider.setRange (0, 5, 0.1);
+        carrierAmplitudeSlider.setValue (1, juce::dontSendNotification);
+        carrierAmplitudeSlider.onValueChange = [this] { synthAudioSource.setCarrierAmplitude(carrierAmplitudeSlider.getValue()); };
+
+        addAndMakeVisible (carrierAttackTimeSlider);
+        carrierAttackTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        carrierAttackTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        carrierAttackTimeSlider.setRange (0, 5, 0.01);
+        carrierAttackTimeSlider.setValue (0, juce::dontSendNotification);
+        carrierAttackTimeSlider.onValueChange = [this] { synthAudioSource.setCarrierAttackTime(carrierAttackTimeSlider.getValue()); };
+
+        addAndMakeVisible (carrierDecayTimeSlider);
+        carrierDecayTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        carrierDecayTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        carrierDecayTimeSlider.setRange (0.01, 5, 0.01);
+        carrierDecayTimeSlider.setValue (0, juce::dontSendNotification);
+        carrierDecayTimeSlider.onValueChange = [this] { synthAudioSource.setCarrierDecayTime(carrierDecayTimeSlider.getValue()); };
+
+        addAndMakeVisible (carrierSustainLevelSlider);
+        carrierSustainLevelSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        carrierSustainLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        carrierSustainLevelSlider.setRange (0.01, 1, 0.01);
+        carrierSustainLevelSlider.setValue (1, juce::dontSendNotification);
+        carrierSustainLevelSlider.onValueChange = [this] { synthAudioSource.setCarrierSustainLevel(carrierSustainLevelSlider.getValue()); };
+
+        addAndMakeVisible (carrierReleaseTimeSlider);
+        carrierReleaseTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        carrierReleaseTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        carrierReleaseTimeSlider.setRange (0.01, 5, 0.01);
+        carrierReleaseTimeSlider.setValue (0, juce::dontSendNotification);
+        carrierReleaseTimeSlider.onValueChange = [this] { synthAudioSource.setCarrierReleaseTime(carrierReleaseTimeSlider.getValue()); };
+
+        modulatorAmplitudeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        modulatorAmplitudeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        modulatorAmplitudeSlider.setRange (0, 5, 0.1);
+        modulatorAmplitudeSlider.setValue (0, juce::dontSendNotification);
+        modulatorAmplitudeSlider.onValueChange = [this] { synthAudioSource.setModulatorAmplitude(modulatorAmplitudeSlider.getValue()); };
+        addAndMakeVisible (modulatorAmplitudeSlider);
+
+        modulatorFreqRatioSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        modulatorFreqRatioSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        modulatorFreqRatioSlider.setRange (0.1, 10, 0.1);
+        modulatorFreqRatioSlider.setValue (1, juce::dontSendNotification);
+        modulatorFreqRatioSlider.onValueChange = [this] { synthAudioSource.setModulatorFreqRatio(modulatorFreqRatioSlider.getValue()); };
+        addAndMakeVisible (modulatorFreqRatioSlider);
+
+        addAndMakeVisible (modulatorAttackTimeSlider);
+        modulatorAttackTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        modulatorAttackTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        modulatorAttackTimeSlider.setRange (0, 5, 0.01);
+        modulatorAttackTimeSlider.setValue (0, juce::dontSendNotification);
+        modulatorAttackTimeSlider.onValueChange = [this] { synthAudioSource.setModulatorAttackTime(modulatorAttackTimeSlider.getValue()); };
+
+        addAndMakeVisible (modulatorDecayTimeSlider);
+        modulatorDecayTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        modulatorDecayTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        modulatorDecayTimeSlider.setRange (0.01, 5, 0.01);
+        modulatorDecayTimeSlider.setValue (0.01, juce::dontSendNotification);
+        modulatorDecayTimeSlider.onValueChange = [this] { synthAudioSource.setModulatorDecayTime(modulatorDecayTimeSlider.getValue()); };
+
+        addAndMakeVisible (modulatorSustainLevelSlider);
+        modulatorSustainLevelSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        modulatorSustainLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        modulatorSustainLevelSlider.setRange (0.01, 1, 0.01);
+        modulatorSustainLevelSlider.setValue (1, juce::dontSendNotification);
+        modulatorSustainLevelSlider.onValueChange = [this] { synthAudioSource.setModulatorSustainLevel(modulatorSustainLevelSlider.getValue()); };
+
+        addAndMakeVisible (modulatorReleaseTimeSlider);
+        modulatorReleaseTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        modulatorReleaseTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        modulatorReleaseTimeSlider.setRange (0.01, 5, 0.01);
+        modulatorReleaseTimeSlider.setValue (0.01, juce::dontSendNotification);
+        modulatorReleaseTimeSlider.onValueChange = [this] { synthAudioSource.setModulatorReleaseTime(modulatorReleaseTimeSlider.getValue()); };
+
+        addAndMakeVisible (feedbackSlider);
+        feedbackSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        feedbackSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        feedbackSlider.setRange (0.0, 1.0, 0.01);
+        feedbackSlider.setValue (0.0, juce::dontSendNotification);
+        feedbackSlider.onValueChange = [this] { synthAudioSource.setFeedback(feedbackSlider.getValue()); };
+        feedbackSlider.setEnabled(false);
+
+        addAndMakeVisible (delayTimeSlider);
+        delayTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        delayTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        delayTimeSlider.setRange (0.0, 1.0, 0.001);
+        delayTimeSlider.setValue (0.0, juce::dontSendNotification);
+        delayTimeSlider.onValueChange = [this] { synthAudioSource.setDelayTime(delayTimeSlider.getValue()); };
+        delayTimeSlider.setEnabled(false);
+
+        addAndMakeVisible (wetDrySlider);
+        wetDrySlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        wetDrySlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        wetDrySlider.setRange (0.0, 1.0, 0.01);
+        wetDrySlider.setValue (0.0, juce::dontSendNotification);
+        wetDrySlider.onValueChange = [this] { synthAudioSource.setWetDry(wetDrySlider.getValue()); };
+        wetDrySlider.setEnabled(false);
+
+        addAndMakeVisible (LFORateSlider);
+        LFORateSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        LFORateSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        LFORateSlider.setRange (0.0, 10.0, 0.01);
+        LFORateSlider.setValue (0.0, juce::dontSendNotification);
+        LFORateSlider.onValueChange = [this] { synthAudioSource.setLFORate(LFORateSlider.getValue()); };
+        addAndMakeVisible (LFODepthSlider);
+        LFODepthSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
+        LFODepthSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
+        LFODepthSlider.setRange (0.0, 0.002, 0.00001);
+        LFODepthSlider.setValue (0.0, juce::dontSendNotification);
+        LFODepthSlider.onValueChange = [this] { synthAudioSource.setLFODepth(LFODepthSlider.getValue()); };
+        LFODepthSlider.setEnabled(false);
+
+        addAndMakeVisible (keyboardComponent);
+        addAndMakeVisible (spectrogramComponent);
+
+        titleLabel                  .setText("GCT535 FM Synthesizer", juce::dontSendNotification);
+        carrierLabel                .setText("Carrier Parameters", juce::dontSendNotification);
+        carrierAmplitudeLabel       .setText("Amplitude", juce::dontSendNotification);
+        carrierAttackTimeLabel      .setText("Attack [s]", juce::dontSendNotification);
+        carrierDecayTimeLabel       .setText("Decay [s]", juce::dontSendNotification);
+        carrierSustainLevelLabel    .setText("Sustain", juce::dontSendNotification);
+        carrierReleaseTimeLabel     .setText("Release [s]", juce::dontSendNotification);
+        modulatorLabel              .setText("Modulator Parameters", juce::dontSendNotification);
+        modulatorAmplitudeLabel     .setText("Amplitude", juce::dontSendNotification);
+        modulatorFreqRatioLabel     .setText("Freq. Ratio", juce::dontSendNotification);
+        modulatorAttackTimeLabel    .setText("Attack [s]", juce::dontSendNotification);
+        modulatorDecayTimeLabel     .setText("Decay [s]", juce::dontSendNotification);
+        modulatorSustainLevelLabel  .setText("Sustain", juce::dontSendNotification);
+        modulatorReleaseTimeLabel   .setText("Release [s]", juce::dontSendNotification);
+        presetListLabel             .setText("Presets", juce::dontSendNotification);
+        fxLabel                     .setText("FX Parameters", juce::dontSendNotification);
+        fxListLabel                 .setText("FX", juce::dontSendNotification);
+        feedbackLabel               .setText("Feedback", juce::dontSendNotification);
+        delayTimeLabel              .setText("Delay Time [s]", juce::dontSendNotification);
+        wetDryLabel                 .setText("Wet/Dry", juce::dontSendNotification);
+        LFORateLabel                .setText("LFO Rate [Hz]", juce::dontSendNotification);
+        LFODepthLabel               .setText("LFO Depth", juce::dontSendNotification);
+
+        titleLabel                  .setJustificationType(juce::Justification::centredLeft);
+        carrierLabel                .setJustificationType(juce::Justification::centred);
+        carrierAmplitudeLabel       .setJustificationType(juce::Justification::centred);
+        carrierAttackTimeLabel      .setJustificationType(juce::Justification::centred);
+        carrierDecayTimeLabel       .setJustificationType(juce::Justification::centred);
+        carrierSustainLevelLabel    .setJustificationType(juce::Justification::centred);
+        carrierReleaseTimeLabel     .setJustificationType(juce::Justification::centred);
+        modulatorLabel              .setJustificationType(juce::Justification::centred);
+        modulatorAmplitudeLabel     .setJustificationType(juce::Justification::centred);
+        modulatorFreqRatioLabel     .setJustificationType(juce::Justification::centred);
+        modulatorAttackTimeLabel    .setJustificationType(juce::Justification::centred);
+        modulatorDecayTimeLabel     .setJustificationType(juce::Justification::centred);
+        modulatorSustainLevelLabel  .setJustificationType(juce::Justification::centred);
+        modulatorReleaseTimeLabel   .setJustificationType(juce::Justification::centred);
+        presetListLabel             .setJustificationType(juce::Justification::centred);
+        fxLabel                     .setJustificationType(juce::Justification::centred);
+        fxListLabel                 .setJustificationType(juce::Justification::centredRight);
+        feedbackLabel               .setJustificationType(juce::Justification::centred);
+        delayTimeLabel              .setJustificationType(juce::Justification::centred);
+        wetDryLabel                 .setJustificationType(juce::Justification::centred);
+        LFORateLabel                .setJustificationType(juce::Justification::centred);
+        LFODepthLabel               .setJustificationType(juce::Justification::centred);
+
+        addAndMakeVisible (titleLabel);
+        addAndMakeVisible (carrierLabel);
+        addAndMakeVisible (carrierAmplitudeLabel);
+        addAndMakeVisible (carrierAttackTimeLabel);
+        addAndMakeVisible (carrierDecayTimeLabel);
+        addAndMakeVisible (carrierSustainLevelLabel);
+        addAndMakeVisible (carrierReleaseTimeLabel);
+        addAndMakeVisible (modulatorLabel);
+        addAndMakeVisible (modulatorAmplitudeLabel);
+        addAndMakeVisible (modulatorFreqRatioLabel);
+        addAndMakeVisible (modulatorAttackTimeLabel);
+        addAndMakeVisible (modulatorDecayTimeLabel);
+        addAndMakeVisible (modulatorSustainLevelLabel);
+        addAndMakeVisible (modulatorReleaseTimeLabel);
+        addAndMakeVisible (presetListLabel);
+        addAndMakeVisible (fxListLabel);
+
+        addAndMakeVisible (fxLabel);
+        addAndMakeVisible (feedbackLabel);
+        addAndMakeVisible (delayTimeLabel);
+        addAndMakeVisible (wetDryLabel);
+        addAndMakeVisible (LFORateLabel);
+        addAndMakeVisible (LFODepthLabel);
+        
+        addAndMakeVisible (presetList);
+        juce::StringArray presetNames;
+        presetNames.add("Default");
+        presetNames.add("Bell");
+        presetNames.add("Brass");
+        presetNames.add("Electric Piano");
+        presetNames.add("Your Sound");
+        presetList.addItemList( presetNames, 1 );
+        presetList.setSelectedItemIndex(0);
+        presetList.onChange = [this] { loadPreset (presetList.getItemText(presetList.getSelectedItemIndex())); };
+        
+        addAndMakeVisible (fxList);
+        juce::StringArray fxNames;
+        fxNames.add("None");
+        fxNames.add("Delay");
+        fxNames.add("Chorus");
+        fxNames.add("Flanger");
+        fxNames.add("MultiTap");
+        fxNames.add("CrossFeedback");
+        fxList.addItemList( fxNames, 1 );
+        fxList.setSelectedItemIndex(0);
+        fxList.onChange = [this] { loadFX (fxList.getItemText(fxList.getSelectedItemIndex())); synthAudioSource.setSampleRate(); };
+
+        setAudioChannels (0, 2);
+        setSize(820, 630);
+        startTimer (400);
+    }
+
+    ~MainContentComponent() override
+    {
+        shutdownAudio();
+    }
+
+    void resized() override
+    {
+        int borderLeft  = 10; 
+        int borderTop   = 10;
+        int dialWidth   = 70;
+        int dialHeight  = 70;
+        int labelHeight = 40;
+
+        carrierLabel                .setBounds (0, borderTop, 410, 20);
+        modulatorLabel              .setBounds (410, borderTop, 410, 20);
+        carrierAmplitudeLabel       .setBounds (borderLeft   + dialWidth*0,  borderTop+25, 70, 20);
+        carrierAttackTimeLabel      .setBounds (borderLeft   + dialWidth*1,  borderTop+25, 70, 20);
+        carrierDecayTimeLabel       .setBounds (borderLeft   + dialWidth*2,  borderTop+25, 70, 20);
+        carrierSustainLevelLabel    .setBounds (borderLeft   + dialWidth*3,  borderTop+25, 70, 20);
+        carrierReleaseTimeLabel     .setBounds (borderLeft   + dialWidth*4,  borderTop+25, 70, 20);
+        modulatorAmplitudeLabel     .setBounds (borderLeft*4 + dialWidth*5,  borderTop+25, 70, 20);
+        modulatorFreqRatioLabel     .setBounds (borderLeft*4 + dialWidth*6,  borderTop+25, 70, 20);
+        modulatorAttackTimeLabel    .setBounds (borderLeft*4 + dialWidth*7,  borderTop+25, 70, 20);
+        modulatorDecayTimeLabel     .setBounds (borderLeft*4 + dialWidth*8,  borderTop+25, 70, 20);
+        modulatorSustainLevelLabel  .setBounds (borderLeft*4 + dialWidth*9,  borderTop+25, 70, 20);
+        modulatorReleaseTimeLabel   .setBounds (borderLeft*4 + dialWidth*10, borderTop+25, 70, 20);
+
+        fxLabel             .setBounds (0, borderTop+labelHeight+dialHeight+10, 410, 20);
+        fxListLabel         .setBounds (410, borderTop+labelHeight+dialHeight+10, 100,  20);
+        fxList              .setBounds (515, borderTop+labelHeight+dialHeight+10, 140, 20);
+        feedbackLabel       .setBounds (borderLeft+dialWidth*1, borderTop+labelHeight+dialHeight+35, 140, 20);
+        delayTimeLabel      .setBounds (borderLeft+dialWidth*3, borderTop+labelHeight+dialHeight+35, 140, 20);
+        wetDryLabel         .setBounds (borderLeft+dialWidth*5, borderTop+labelHeight+dialHeight+35, 140, 20);
+        LFORateLabel        .setBounds (borderLeft+dialWidth*7, borderTop+labelHeight+dialHeight+35, 140, 20);
+        LFODepthLabel       .setBounds (borderLeft+dialWidth*9, borderTop+labelHeight+dialHeight+35, 140, 20);
+
+        carrierAmplitudeSlider      .setBounds (borderLeft   + dialWidth*0,  borderTop+labelHeight, dialWidth, dialHeight);
+        carrierAttackTimeSlider     .setBounds (borderLeft   + dialWidth*1,  borderTop+labelHeight, dialWidth, dialHeight);
+        carrierDecayTimeSlider      .setBounds (borderLeft   + dialWidth*2,  borderTop+labelHeight, dialWidth, dialHeight);
+        carrierSustainLevelSlider   .setBounds (borderLeft   + dialWidth*3,  borderTop+labelHeight, dialWidth, dialHeight);
+        carrierReleaseTimeSlider    .setBounds (borderLeft   + dialWidth*4,  borderTop+labelHeight, dialWidth, dialHeight);
+        modulatorAmplitudeSlider    .setBounds (borderLeft*4 + dialWidth*5,  borderTop+labelHeight, dialWidth, dialHeight);
+        modulatorFreqRatioSlider    .setBounds (borderLeft*4 + dialWidth*6,  borderTop+labelHeight, dialWidth, dialHeight);
+        modulatorAttackTimeSlider   .setBounds (borderLeft*4 + dialWidth*7,  borderTop+labelHeight, dialWidth, dialHeight);
+        modulatorDecayTimeSlider    .setBounds (borderLeft*4 + dialWidth*8,  borderTop+labelHeight, dialWidth, dialHeight);
+        modulatorSustainLevelSlider .setBounds (borderLeft*4 + dialWidth*9,  borderTop+labelHeight, dialWidth, dialHeight);
+        modulatorReleaseTimeSlider  .setBounds (borderLeft*4 + dialWidth*10, borderTop+labelHeight, dialWidth, dialHeight);
+        
+        feedbackSlider              .setBounds (borderLeft+dialWidth*1+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
+        delayTimeSlider             .setBounds (borderLeft+dialWidth*3+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
+        wetDrySlider                .setBounds (borderLeft+dialWidth*5+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
+        LFORateSlider               .setBounds (borderLeft+dialWidth*7+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
+        LFODepthSlider              .setBounds (borderLeft+dialWidth*9+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
+
+        keyboardComponent           .setBounds (borderLeft, 250, 800, 150);
+
+        titleLabel                  .setBounds ( 30,  405, 300, 20);
+        presetListLabel             .setBounds ( 595, 405, 80,  20);
+        presetList                  .setBounds ( 665, 405, 120, 20);
+
+        spectrogramComponent        .setBounds (borderLeft, 435, 800, 185);
+    }
+
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override
+    {
+        synthAudioSource.prepareToPlay (samplesPerBlockExpected, sampleRate);
+        synthAudioSource.setSampleRate();
+        spectrogramAnalyser.setSampleRate (sampleRate);
+    }
+
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override
+    {
+        synthAudioSource.getNextAudioBlock (bufferToFill);
+        spectrogramAnalyser.pushAudio (bufferToFill);
+    }
+
+    void releaseResources() override
+    {
+        synthAudioSource.releaseResources();
+    }
+
+private:
+    void timerCallback() override
+    {
+        keyboardComponent.grabKeyboardFocus();
+        stopTimer();
+    }
+
+    juce::Label titleLabel;
+    juce::Label carrierLabel;
+    juce::Label modulatorLabel;
+
+    juce::Label carrierAmplitudeLabel;
+    juce::Label carrierAttackTimeLabel;
+    juce::Label carrierDecayTimeLabel;
+    juce::Label carrierSustainLevelLabel;
+    juce::Label carrierReleaseTimeLabel;
+    juce::Slider carrierAmplitudeSlider;
+    juce::Slider carrierAttackTimeSlider;
+    juce::Slider carrierDecayTimeSlider;
+    juce::Slider carrierSustainLevelSlider;
+    juce::Slider carrierReleaseTimeSlider;
+
+    juce::Label modulatorAmplitudeLabel;
+    juce::Label modulatorFreqRatioLabel;
+    juce::Label modulatorAttackTimeLabel;
+    juce::Label modulatorDecayTimeLabel;
+    juce::Label modulatorSustainLevelLabel;
+    juce::Label modulatorReleaseTimeLabel;
+    juce::Slider modulatorAmplitudeSlider;
+    juce::Slider modulatorFreqRatioSlider;
+    juce::Slider modulatorAttackTimeSlider;
+    juce::Slider modulatorDecayTimeSlider;
+    juce::Slider modulatorSustainLevelSlider;
+    juce::Slider modulatorReleaseTimeSlider;
+
+    juce::MidiKeyboardState keyboardState;
+    SynthAudioSource synthAudioSource;
+    juce::MidiKeyboardComponent keyboardComponent;
+
+    juce::Label presetListLabel;
+    juce::ComboBox presetList;
+
+    juce::Label fxLabel;
+    juce::Label feedbackLabel;
+    juce::Label delayTimeLabel;
+    juce::Label wetDryLabel;
+    juce::Label LFORateLabel;
+    juce::Label LFODepthLabel;
+    juce::Slider feedbackSlider;
+    juce::Slider delayTimeSlider;
+    juce::Slider wetDrySlider;
+    juce::Slider LFORateSlider;
+    juce::Slider LFODepthSlider;
+
+    juce::Label fxListLabel;
+    juce::ComboBox fxList;
+
+    SpectrogramAnalyser spectrogramAnalyser;
+    SpectrogramComponent spectrogramComponent { spectrogramAnalyser };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainContentComponent)
+};
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    MultiTapDelay.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayLine.h"
+
+//==============================================================================
+// one tap of a MultiTapDelay.
+struct DelayTap
+{
+    float delayTime = 0.0f;     // in seconds
+    float gain      = 1.0f;
+    float pan       = 0.0f;     // -1 (left) to 1 (right), constant power
+    float cutoff    = 20000.0f; // of a one-pole lowpass, in Hz; at or above Nyquist the tap is not filtered
+};
+
+//==============================================================================
+// Up to 32 taps read from delay lines owned by the caller, one per channel, so the taps share
+// a single buffer per channel instead of keeping one each. A block is written to the lines and
+// read back in chunks of 64 samples: the taps of a chunk add into accumulators that stay in
+// the L1 cache, so the input and output are passed once per block and each tap only streams
+// its own span of the line. With two channels each tap reads the mid of both lines and pans
+// it; otherwise each channel's taps go to that channel. A tap whose delay changes is
+// crossfaded from the old delay to the new one over a chunk.
+template <typename Type, size_t maxNumChannels = 2>
+class MultiTapDelay
+{
+public:
+    static constexpr size_t maxNumTaps = 32;
+    static constexpr size_t chunkSize  = 64;
+
+    // four taps an eighth of a second apart, panned left and right and darker with each repeat.
+    MultiTapDelay()
+    {
+        for (size_t i = 0; i < 4; ++i)
+        {
+            DelayTap tap;
+            tap.delayTime = 0.125f * (float) (i + 1);
+            tap.gain      = 0.7f / (float) (i + 1);
+            tap.pan       = (i % 2 == 0 ? -0.6f : 0.6f);
+            tap.cutoff    = 8000.0f / (float) (i + 1);
+            setTap (i, tap);
+        }
+
+        setNumTaps (4);
+        previousDelaySamples = delaySamples;
+    }
+
+    void setSampleRate (Type newValue) noexcept
+    {
+        sampleRate = newValue;
+
+        for (size_t i = 0; i < maxNumTaps; ++i)
+            updateTap (i);
+    }
+
+    void setNumTaps (size_t newValue) noexcept
+    {
+        jassert (newValue <= maxNumTaps);
+        numTaps = juce::jmin (newValue, maxNumTaps);
+    }
+
+    size_t getNumTaps() const noexcept                       { return numTaps; }
+
+    void setTap (size_t index, const DelayTap& newValue) noexcept
+    {
+        if (index >= maxNumTaps)
+        {
+            jassertfalse;
+            return;
+        }
+
+        jassert (newValue.delayTime >= 0.0f);
+        taps[index] = newValue;
+        updateTap (index);
+    }
+
+    const DelayTap& getTap (size_t index) const noexcept     { return taps[index]; }
+
+    void reset() noexcept
+    {
+        for (auto& states : filterStates)
+            states.fill (Type (0));
+
+        previousDelaySamples = delaySamples;
+    }
+
+    // write the input to the delay lines, starting at the write pointers, and set the output to
+    // the input faded by wetDry into the sum of the taps; the write pointers are advanced.
+    template <typename InputBlock, typename OutputBlock>
+    void process (DelayLine<Type>* delayLines, size_t* writePointers,
+                  const InputBlock& inputBlock, OutputBlock& outputBlock, Type wetDry) noexcept
+    {
+        auto numSamples  = outputBlock.getNumSamples();
+        auto numChannels = juce::jmin (outputBlock.getNumChannels(), maxNumChannels);
+        auto panned = (numChannels == 2);
+
+        for (size_t start = 0; start < numSamples; start += chunkSize)
+        {
+            auto numThisTime = juce::jmin (chunkSize, numSamples - start);
+            auto maxDelay = delayLines[0].size() - chunkSize;
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                delayLines[ch].write (writePointers[ch], inputBlock.getChannelPointer (ch) + start, numThisTime);
+                std::fill_n (sums[ch].data(), numThisTime, Type (0));
+            }
+
+            for (size_t i = 0; i < numTaps; ++i)
+            {
+                auto from = juce::jmin (previousDelaySamples[i], maxDelay);
+                auto to   = juce::jmin (delaySamples[i], maxDelay);
+
+                if (panned)
+                {
+                    delayLines[0].readCrossfaded (writePointers[0], from, to, scratch.data(), numThisTime);
+                    delayLines[1].readCrossfaded (writePointers[1], from, to, signal.data(), numThisTime);
+
+                    for (size_t n = 0; n < numThisTime; ++n)
+                        signal[n] = Type (0.5) * (signal[n] + scratch[n]);
+
+                    filter (i, 0, numThisTime);
+                    addTo (sums[0].data(), tapGains[i][0], numThisTime);
+                    addTo (sums[1].data(), tapGains[i][1], numThisTime);
+                }
+                else
+                {
+                    for (size_t ch = 0; ch < numChannels; ++ch)
+                    {
+                        delayLines[ch].readCrossfaded (writePointers[ch], from, to, signal.data(), numThisTime);
+                        filter (i, ch, numThisTime);
+                        addTo (sums[ch].data(), (Type) taps[i].gain, numThisTime);
+                    }
+                }
+
+                previousDelaySamples[i] = delaySamples[i];
+            }
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                auto* input  = inputBlock .getChannelPointer (ch) + start;
+                auto* output = outputBlock.getChannelPointer (ch) + start;
+
+                for (size_t n = 0; n < numThisTime; ++n)
+                    output[n] = input[n] + wetDry * (sums[ch][n] - input[n]);
+
+                writePointers[ch] += numThisTime;
+            }
+        }
+    }
+
+private:
+    void updateTap (size_t index) noexcept
+    {
+        auto& tap = taps[index];
+        delaySamples[index] = (size_t) std::lround ((double) tap.delayTime * (double) sampleRate);
+
+        // unity at the centre, as both channels then carry the tap at full level
+        auto angle = (juce::jlimit (-1.0f, 1.0f, tap.pan) + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+        tapGains[index] = { (Type) (tap.gain * juce::MathConstants<float>::sqrt2 * std::cos (angle)),
+                            (Type) (tap.gain * juce::MathConstants<float>::sqrt2 * std::sin (angle)) };
+
+        auto nyquist = (float) sampleRate * 0.5f;
+        filterCoefficients[index] = tap.cutoff >= nyquist
+                                      ? Type (1)
+                                      : (Type) (1.0 - std::exp (-juce::MathConstants<double>::twoPi * tap.cutoff / (double) sampleRate));
+    }
+
+    // one-pole lowpass of signal[] in place, with the state of a tap and channel.
+    void filter (size_t tap, size_t channel, size_t numSamples) noexcept
+    {
+        auto a = filterCoefficients[tap];
+
+        if (a >= Type (1))
+            return;
+
+        auto y = filterStates[tap][channel];
+
+        for (size_t n = 0; n < numSamples; ++n)
+            signal[n] = y += a * (signal[n] - y);
+
+        filterStates[tap][channel] = y;
+    }
+
+    void addTo (Type* sum, Type gain, size_t numSamples) const noexcept
+    {
+        for (size_t n = 0; n < numSamples; ++n)
+            sum[n] += gain * signal[n];
+    }
+
+    std::array<DelayTap, maxNumTaps> taps;
+    std::array<size_t, maxNumTaps> delaySamples {}, previousDelaySamples {};
+    std::array<std::array<Type, 2>, maxNumTaps> tapGains {};
+    std::array<Type, maxNumTaps> filterCoefficients {};
+    std::array<std::array<Type, maxNumChannels>, maxNumTaps> filterStates {};
+    size_t numTaps = 0;
+    Type sampleRate { Type (48000) };
+
+    std::array<std::array<Type, chunkSize>, maxNumChannels> sums;
+    std::array<Type, chunkSize> signal, scratch;
+};
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    ParameterStore.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// Triple buffer that hands whole parameter sets from one writer thread (the GUI) to one
+// reader thread (audio) without locks. The writer fills a slot of its own and swaps it
+// with the shared middle slot; the reader swaps the middle slot with its own only when a
+// newer set has been published. Each side only ever touches its own slot, so the reader
+// always sees one complete set, never a mix of an old and a new one, and neither side waits.
+template <typename Parameters>
+class ParameterStore
+{
+public:
+    explicit ParameterStore (const Parameters& initialValue = {})
+        : published (initialValue)
+    {
+        slots.fill (initialValue);
+    }
+
+    // writer thread: make newValue the set the reader gets from its next update().
+    void publish (const Parameters& newValue)
+    {
+        published = newValue;
+        slots[(size_t) writeSlot] = newValue;
+        writeSlot = middleSlot.exchange (writeSlot | newDataFlag, std::memory_order_acq_rel) & slotMask;
+    }
+
+    // writer thread: the set last given to publish(), for changing a single member.
+    const Parameters& getPublished() const noexcept     { return published; }
+
+    // reader thread: take the newest published set, if any. Returns true if it changed.
+    bool update() noexcept
+    {
+        if ((middleSlot.load (std::memory_order_relaxed) & newDataFlag) == 0)
+            return false;
+
+        readSlot = middleSlot.exchange (readSlot, std::memory_order_acq_rel) & slotMask;
+        return true;
+    }
+
+    // reader thread: the set taken by the last update().
+    const Parameters& get() const noexcept              { return slots[(size_t) readSlot]; }
+
+private:
+    static constexpr int slotMask = 3, newDataFlag = 4;
+
+    std::array<Parameters, 3> slots;
+    Parameters published;
+    int writeSlot = 0, readSlot = 1;
+    std::atomic<int> middleSlot { 2 };
+};
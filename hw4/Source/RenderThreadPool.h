@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    RenderThreadPool.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Semaphore.h"
+
+//==============================================================================
+// Worker threads that share the jobs of one render pass with the audio thread. The audio
+// thread publishes a pass by storing a single atomic word and then claims jobs itself, so
+// every job that no worker has claimed yet, because its worker was not scheduled in time,
+// is taken back and run by the audio thread; it only waits for jobs that a worker is already
+// running, so the wait is bounded by the length of one job. A worker that finds no job to
+// claim sleeps on its RealtimeSemaphore until the next pass, so the pool uses no CPU between
+// passes. The audio thread wakes only the workers that are asleep, each with one signal of
+// its semaphore, which takes no lock.
+class RenderThreadPool
+{
+public:
+    using Job = std::function<void (int)>;
+
+    ~RenderThreadPool()
+    {
+        setNumWorkers (0);
+    }
+
+    // start or stop workers; not to be called while run() is in progress.
+    void setNumWorkers (int numWorkers)
+    {
+        juce::CriticalSection noLock;
+        setNumWorkers (numWorkers, noLock);
+    }
+
+    // start or stop workers while run() may be called under runLock. The new workers are
+    // started and the old ones stopped outside the lock; only swapping them holds it.
+    void setNumWorkers (int numWorkers, const juce::CriticalSection& runLock)
+    {
+        std::vector<std::unique_ptr<Worker>> newWorkers;
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            newWorkers.push_back (std::make_unique<Worker> (*this));
+            newWorkers.back()->startThread (juce::Thread::realtimeAudioPriority);
+        }
+
+        {
+            const juce::ScopedLock sl (runLock);
+            std::swap (workers, newWorkers);
+        }
+
+        // ask every old worker to exit before waiting for any of them
+        for (auto& worker : newWorkers)
+        {
+            worker->signalThreadShouldExit();
+            worker->wake();
+        }
+
+        newWorkers.clear();
+    }
+
+    int getNumWorkers() const noexcept                      { return (int) workers.size(); }
+
+    // call job (i) once for every i in [0, numJobs) on this thread and the workers, and return
+    // when all calls have finished. The job is held by reference, so it should outlive the call.
+    void run (const Job& job, int numJobs)
+    {
+        jassert (numJobs <= maxJobs);
+
+        if (workers.empty() || numJobs <= 1)
+        {
+            for (int i = 0; i < numJobs; ++i)
+                job (i);
+
+            return;
+        }
+
+        currentJob = &job;
+        finishedJobs.store (0, std::memory_order_relaxed);
+
+        auto newPass = ((state.load (std::memory_order_relaxed) >> passShift) + 1) << passShift;
+        state.store (newPass | ((juce::uint64) numJobs << jobCountShift));
+
+        // sequentially consistent with Worker::run, so a worker either sees this pass before it
+        // sleeps or is seen asleep here
+        for (auto& worker : workers)
+            worker->wake();
+
+        // claims every job no worker has started, then spins only on the jobs being run
+        runJobs();
+
+        while (finishedJobs.load (std::memory_order_acquire) < numJobs)
+        {
+        }
+    }
+
+    // the most jobs a single pass can have.
+    static constexpr int maxJobs = 0xffff;
+
+private:
+    // the pass number, the job count and the next job to claim, packed into one word so that
+    // a worker that wakes late can never claim a job of a pass it did not read the count of.
+    static constexpr int passShift = 32, jobCountShift = 16;
+    static constexpr juce::uint64 jobMask = 0xffff;
+
+    bool hasUnclaimedJobs() const noexcept
+    {
+        auto current = state.load();
+        return (int) (current & jobMask) < (int) ((current >> jobCountShift) & jobMask);
+    }
+
+    bool claimJob (int& jobIndex) noexcept
+    {
+        auto current = state.load (std::memory_order_acquire);
+
+        for (;;)
+        {
+            auto next = (int) (current & jobMask);
+
+            if (next >= (int) ((current >> jobCountShift) & jobMask))
+                return false;
+
+            if (state.compare_exchange_weak (current, current + 1, std::memory_order_acq_rel))
+            {
+                jobIndex = next;
+                return true;
+            }
+        }
+    }
+
+    // returns true if any job was run.
+    bool runJobs()
+    {
+        auto ranAny = false;
+        int jobIndex;
+
+        while (claimJob (jobIndex))
+        {
+            // a claimed job keeps its pass open, so currentJob cannot change until it is counted
+            (*currentJob) (jobIndex);
+            finishedJobs.fetch_add (1, std::memory_order_acq_rel);
+            ranAny = true;
+        }
+
+        return ranAny;
+    }
+
+    struct Worker   : public juce::Thread
+    {
+        explicit Worker (RenderThreadPool& p) : juce::Thread ("Voice render worker"), pool (p) {}
+
+        ~Worker() override
+        {
+            signalThreadShouldExit();
+            wake();
+            stopThread (1000);
+        }
+
+        // wake the worker if it is asleep; takes no lock, so the audio thread can call it.
+        void wake() noexcept
+        {
+            if (sleeping.exchange (false))
+                semaphore.signal();
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                if (pool.runJobs())
+                    continue;
+
+                sleeping.store (true);
+
+                if (! pool.hasUnclaimedJobs() && ! threadShouldExit())
+                {
+                    // a signal sent after the check is kept by the semaphore, so it cannot be missed
+                    semaphore.wait();
+                }
+                else if (! sleeping.exchange (false))
+                {
+                    // woken while deciding not to sleep; take the signal so it cannot end a later sleep
+                    semaphore.wait();
+                }
+            }
+        }
+
+        RenderThreadPool& pool;
+        RealtimeSemaphore semaphore;
+        std::atomic<bool> sleeping { false };
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<juce::uint64> state { 0 };
+    std::atomic<int> finishedJobs { 0 };
+    const Job* currentJob = nullptr;
+};
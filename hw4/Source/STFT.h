@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    STFT.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// The short-time Fourier transform of one channel, as stft (x, window, hop_size, fft_size) of
+// homework 1: frame k is the windowSize samples from k * hopSize on, multiplied by the window,
+// zero-padded to fftSize and transformed with the real-only FFT, of which the fftSize / 2 + 1
+// non-negative bins are kept as separate real and imaginary arrays. process() takes blocks of
+// any size and calls back with each frame as soon as its last sample arrives, so frames come
+// at the hop rate whatever the block size; the input is kept in a buffer of one window, shifted
+// by the hop after each frame. processFrames() computes every frame of a whole signal at once
+// for offline use, into arrays given by the caller, with the same results. Everything is
+// allocated in prepare(), so process() can run on the audio thread.
+class StreamingSTFT
+{
+public:
+    // allocate the FFT and buffers for frames of windowSize samples every hopSize samples,
+    // zero-padded to fftSize, a power of two; the window is a periodic Hann window.
+    void prepare (size_t newWindowSize, size_t newHopSize, size_t newFFTSize)
+    {
+        jassert (juce::isPowerOfTwo (newFFTSize) && newWindowSize <= newFFTSize && newHopSize > 0);
+
+        fftSize = newFFTSize;
+        windowSize = juce::jmin (newWindowSize, fftSize);
+        hopSize = juce::jmax ((size_t) 1, newHopSize);
+        numBins = fftSize / 2 + 1;
+        fft = std::make_unique<juce::dsp::FFT> (juce::roundToInt (std::log2 ((double) fftSize)));
+
+        window.resize (windowSize);
+
+        for (size_t n = 0; n < windowSize; ++n)
+            window[n] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * (float) n / (float) windowSize);
+
+        fftBuffer.assign (2 * fftSize, 0.0f);
+        inputBuffer.assign (windowSize, 0.0f);
+        frameReal.assign (numBins, 0.0f);
+        frameImag.assign (numBins, 0.0f);
+        reset();
+    }
+
+    // replace the Hann window by windowSize samples of newWindow.
+    void setWindow (const float* newWindow) noexcept
+    {
+        std::copy_n (newWindow, windowSize, window.begin());
+    }
+
+    // forget the buffered input, so the next sample starts frame 0.
+    void reset() noexcept
+    {
+        numBuffered = 0;
+        samplesToSkip = 0;
+        numFrames = 0;
+    }
+
+    size_t getWindowSize() const noexcept                   { return windowSize; }
+    size_t getHopSize() const noexcept                      { return hopSize; }
+    size_t getFFTSize() const noexcept                      { return fftSize; }
+    size_t getNumBins() const noexcept                      { return numBins; }
+
+    // the number of frames emitted since the last reset().
+    juce::int64 getNumFramesEmitted() const noexcept        { return numFrames; }
+
+    // the number of frames in a signal of numSamples samples, as processFrames() computes them.
+    size_t getNumFrames (size_t numSamples) const noexcept
+    {
+        return numSamples < windowSize ? 0 : (numSamples - windowSize) / hopSize + 1;
+    }
+
+    // add numSamples samples of input and call onFrame (frameIndex, real, imag) with the
+    // getNumBins() bins of every frame that is completed, in order.
+    template <typename Callback>
+    void process (const float* input, size_t numSamples, Callback&& onFrame)
+    {
+        while (numSamples > 0)
+        {
+            if (samplesToSkip > 0)
+            {
+                auto n = juce::jmin (samplesToSkip, numSamples);
+                samplesToSkip -= n;
+                input += n;
+                numSamples -= n;
+                continue;
+            }
+
+            auto n = juce::jmin (windowSize - numBuffered, numSamples);
+            std::copy_n (input, n, inputBuffer.data() + numBuffered);
+            numBuffered += n;
+            input += n;
+            numSamples -= n;
+
+            if (numBuffered < windowSize)
+                break;
+
+            transform (inputBuffer.data(), frameReal.data(), frameImag.data());
+            onFrame (numFrames++, (const float*) frameReal.data(), (const float*) frameImag.data());
+
+            // keep the overlap with the next frame, or skip the gap before it
+            auto overlap = windowSize - juce::jmin (hopSize, windowSize);
+            std::copy_n (inputBuffer.data() + (windowSize - overlap), overlap, inputBuffer.data());
+            numBuffered = overlap;
+            samplesToSkip = hopSize - juce::jmin (hopSize, windowSize);
+        }
+    }
+
+    // every frame of numSamples samples of input, frame k into real and imag from k * getNumBins();
+    // both need room for getNumFrames (numSamples) * getNumBins() values. The buffered input of
+    // process() is left as it was. Returns the number of frames.
+    size_t processFrames (const float* input, size_t numSamples, float* real, float* imag) noexcept
+    {
+        auto frames = getNumFrames (numSamples);
+
+        for (size_t k = 0; k < frames; ++k)
+            transform (input + k * hopSize, real + k * numBins, imag + k * numBins);
+
+        return frames;
+    }
+
+private:
+    // window windowSize samples, zero-pad them to fftSize and split the non-negative bins.
+    void transform (const float* samples, float* real, float* imag) noexcept
+    {
+        for (size_t n = 0; n < windowSize; ++n)
+            fftBuffer[n] = window[n] * samples[n];
+
+        std::fill (fftBuffer.begin() + (std::ptrdiff_t) windowSize, fftBuffer.end(), 0.0f);
+        fft->performRealOnlyForwardTransform (fftBuffer.data(), true);
+
+        for (size_t k = 0; k < numBins; ++k)
+        {
+            real[k] = fftBuffer[2 * k];
+            imag[k] = fftBuffer[2 * k + 1];
+        }
+    }
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window, fftBuffer, inputBuffer, frameReal, frameImag;
+    size_t windowSize = 0, hopSize = 0, fftSize = 0, numBins = 0;
+    size_t numBuffered = 0, samplesToSkip = 0;
+    juce::int64 numFrames = 0;
+};
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    Semaphore.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+ #endif
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+ #include <cerrno>
+#endif
+
+//==============================================================================
+// A counting semaphore that the audio thread can signal. The count is kept in an atomic, so
+// a signal that no thread waits for is one atomic add, and a signal that wakes a thread is
+// one post of the operating system's semaphore, which takes no lock in user space: a futex
+// on Linux, a dispatch semaphore on macOS and a kernel semaphore on Windows. Waiting may
+// sleep, so only threads other than the audio thread should wait.
+class RealtimeSemaphore
+{
+public:
+    RealtimeSemaphore()
+    {
+       #if JUCE_WINDOWS
+        handle = CreateSemaphoreW (nullptr, 0, std::numeric_limits<LONG>::max(), nullptr);
+       #elif JUCE_MAC || JUCE_IOS
+        handle = dispatch_semaphore_create (0);
+       #else
+        sem_init (&handle, 0, 0);
+       #endif
+    }
+
+    ~RealtimeSemaphore()
+    {
+       #if JUCE_WINDOWS
+        CloseHandle (handle);
+       #elif JUCE_MAC || JUCE_IOS
+        dispatch_release (handle);
+       #else
+        sem_destroy (&handle);
+       #endif
+    }
+
+    // add numToAdd to the count, waking up to numToAdd waiting threads.
+    void signal (int numToAdd = 1) noexcept
+    {
+        // a negative count is the number of threads waiting
+        auto previous = count.fetch_add (numToAdd, std::memory_order_release);
+        auto numToWake = juce::jmin (numToAdd, -previous);
+
+        if (numToWake > 0)
+            post (numToWake);
+    }
+
+    // take one from the count, sleeping until a signal if it is not positive.
+    void wait() noexcept
+    {
+        if (count.fetch_sub (1, std::memory_order_acquire) <= 0)
+            sleep();
+    }
+
+private:
+    void post (int numToWake) noexcept
+    {
+       #if JUCE_WINDOWS
+        ReleaseSemaphore (handle, numToWake, nullptr);
+       #elif JUCE_MAC || JUCE_IOS
+        while (--numToWake >= 0)
+            dispatch_semaphore_signal (handle);
+       #else
+        while (--numToWake >= 0)
+            sem_post (&handle);
+       #endif
+    }
+
+    void sleep() noexcept
+    {
+       #if JUCE_WINDOWS
+        WaitForSingleObject (handle, INFINITE);
+       #elif JUCE_MAC || JUCE_IOS
+        dispatch_semaphore_wait (handle, DISPATCH_TIME_FOREVER);
+       #else
+        while (sem_wait (&handle) != 0 && errno == EINTR) {}
+       #endif
+    }
+
+    std::atomic<int> count { 0 };
+
+   #if JUCE_WINDOWS
+    HANDLE handle;
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_t handle;
+   #else
+    sem_t handle;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (RealtimeSemaphore)
+};
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    Spectrogram.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "STFT.h"
+
+//==============================================================================
+// A wait-free single-producer, single-consumer FIFO of mono samples on a juce::AbstractFifo.
+// push() writes the mix of a buffer's channels and pop() reads them on another thread; the
+// positions are atomics that each side only advances, so neither side ever waits for the
+// other. When the FIFO is full the samples that do not fit are dropped.
+class SampleFIFO
+{
+public:
+    explicit SampleFIFO (int capacity)
+        : fifo (capacity + 1), samples ((size_t) capacity + 1, 0.0f)
+    {
+    }
+
+    // the mean of the channels of numSamples samples of buffer from startSample.
+    void push (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        mix (buffer, startSample, samples.data() + start1, size1);
+        mix (buffer, startSample + size1, samples.data() + start2, size2);
+        fifo.finishedWrite (size1 + size2);
+    }
+
+    void push (const float* input, int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        std::copy_n (input, size1, samples.data() + start1);
+        std::copy_n (input + size1, size2, samples.data() + start2);
+        fifo.finishedWrite (size1 + size2);
+    }
+
+    // read up to maxNumSamples samples into output; returns the number read.
+    int pop (float* output, int maxNumSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (maxNumSamples, start1, size1, start2, size2);
+
+        std::copy_n (samples.data() + start1, size1, output);
+        std::copy_n (samples.data() + start2, size2, output + size1);
+        fifo.finishedRead (size1 + size2);
+        return size1 + size2;
+    }
+
+private:
+    static void mix (const juce::AudioBuffer<float>& buffer, int startSample, float* output, int numSamples) noexcept
+    {
+        auto numChannels = buffer.getNumChannels();
+
+        if (numSamples <= 0 || numChannels == 0)
+        {
+            std::fill_n (output, juce::jmax (0, numSamples), 0.0f);
+            return;
+        }
+
+        std::copy_n (buffer.getReadPointer (0, startSample), numSamples, output);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+        {
+            auto* input = buffer.getReadPointer (ch, startSample);
+
+            for (int i = 0; i < numSamples; ++i)
+                output[i] += input[i];
+        }
+
+        auto gain = 1.0f / (float) numChannels;
+
+        for (int i = 0; i < numSamples; ++i)
+            output[i] *= gain;
+    }
+
+    juce::AbstractFifo fifo;
+    std::vector<float> samples;
+};
+
+//==============================================================================
+// Analyses the output of the audio callback for display. The audio thread only copies its
+// blocks into a SampleFIFO with pushAudio(), which neither locks nor allocates; a background
+// thread drains it, runs a StreamingSTFT and passes each frame's bins in dB, as a column of
+// the spectrogram, and the samples themselves, for an oscilloscope, on to the GUI through two
+// more wait-free FIFOs. Everything is allocated in the constructor, and if the analyser or
+// the GUI fall behind, the newest data is dropped rather than waited for.
+class SpectrogramAnalyser : private juce::Thread
+{
+public:
+    static constexpr size_t windowSize = 1024, hopSize = 256, fftSize = 1024;
+    static constexpr int maxNumColumns = 256, scopeCapacity = 8192;
+
+    SpectrogramAnalyser()
+        : juce::Thread ("Spectrogram"),
+          audioFIFO (65536), scopeFIFO (scopeCapacity), columnFIFO (maxNumColumns + 1)
+    {
+        stft.prepare (windowSize, hopSize, fftSize);
+        columns.assign ((size_t) (maxNumColumns + 1) * getNumBins(), 0.0f);
+        scratch.assign (4096, 0.0f);
+        startThread();
+    }
+
+    ~SpectrogramAnalyser() override
+    {
+        stopThread (1000);
+    }
+
+    // the sample rate of the audio, for the frequency axis; call from prepareToPlay().
+    void setSampleRate (double newValue) noexcept           { sampleRate = newValue; }
+    double getSampleRate() const noexcept                   { return sampleRate; }
+
+    size_t getNumBins() const noexcept                      { return stft.getNumBins(); }
+
+    // copy the block of an audio callback into the FIFO; called on the audio thread.
+    void pushAudio (const juce::AudioSourceChannelInfo& bufferToFill) noexcept
+    {
+        audioFIFO.push (*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+    }
+
+    // the oldest column not yet read, getNumBins() levels in dB from 0 Hz up; returns false if there is none.
+    bool popColumn (float* decibels) noexcept
+    {
+        int start1, size1, start2, size2;
+        columnFIFO.prepareToRead (1, start1, size1, start2, size2);
+
+        if (size1 == 0)
+            return false;
+
+        std::copy_n (columns.data() + (size_t) start1 * getNumBins(), getNumBins(), decibels);
+        columnFIFO.finishedRead (1);
+        return true;
+    }
+
+    // read up to maxNumSamples of the analysed samples, oldest first; returns the number read.
+    int popScope (float* output, int maxNumSamples) noexcept
+    {
+        return scopeFIFO.pop (output, maxNumSamples);
+    }
+
+private:
+    void run() override
+    {
+        // a full-scale sine at the centre of a bin reads 0 dB
+        auto scale = 2.0f / (0.5f * (float) windowSize);
+
+        while (! threadShouldExit())
+        {
+            auto numSamples = audioFIFO.pop (scratch.data(), (int) scratch.size());
+
+            if (numSamples == 0)
+            {
+                wait (5);
+                continue;
+            }
+
+            scopeFIFO.push (scratch.data(), numSamples);
+
+            stft.process (scratch.data(), (size_t) numSamples, [this, scale] (juce::int64, const float* real, const float* imag)
+            {
+                int start1, size1, start2, size2;
+                columnFIFO.prepareToWrite (1, start1, size1, start2, size2);
+
+                if (size1 == 0)
+                    return;
+
+                auto* column = columns.data() + (size_t) start1 * getNumBins();
+
+                for (size_t k = 0; k < getNumBins(); ++k)
+                    column[k] = 10.0f * std::log10 ((real[k] * real[k] + imag[k] * imag[k]) * scale * scale + 1.0e-12f);
+
+                columnFIFO.finishedWrite (1);
+            });
+        }
+    }
+
+    SampleFIFO audioFIFO, scopeFIFO;
+    juce::AbstractFifo columnFIFO;
+    std::vector<float> columns, scratch;
+    StreamingSTFT stft;
+    std::atomic<double> sampleRate { 48000.0 };
+
+    JUCE_DECLARE_NON_COPYABLE (SpectrogramAnalyser)
+};
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    SpectrogramComponent.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Spectrogram.h"
+
+//==============================================================================
+// A scrolling spectrogram with an oscilloscope beside it, drawn from a SpectrogramAnalyser.
+// A timer on the message thread pops the columns analysed since its last tick and writes each
+// into one column of an image that is used as a ring, so a tick costs only the new columns;
+// paint() draws the image in two pieces, the oldest column at the left, so a repaint costs the
+// same however much history is shown and nothing is scrolled by copying. The rows are spaced
+// logarithmically in frequency, each showing the loudest of its bins. The oscilloscope shows
+// scopeLength samples from a rising zero crossing, so a steady tone stands still.
+class SpectrogramComponent   : public juce::Component,
+                               private juce::Timer
+{
+public:
+    static constexpr int scopeLength = 1024;
+    static constexpr float minDecibels = -100.0f, minFrequency = 40.0f;
+
+    explicit SpectrogramComponent (SpectrogramAnalyser& analyserToUse)
+        : analyser (analyserToUse)
+    {
+        column.assign (analyser.getNumBins(), minDecibels);
+        scopeHistory.assign (2 * scopeLength, 0.0f);
+        scopeScratch.assign (SpectrogramAnalyser::scopeCapacity, 0.0f);
+
+        // silence at minDecibels is black, full scale yellow
+        juce::ColourGradient gradient (juce::Colours::black, 0.0f, 0.0f, juce::Colours::yellow, 1.0f, 0.0f, false);
+        gradient.addColour (0.35, juce::Colours::darkblue);
+        gradient.addColour (0.6,  juce::Colours::purple);
+        gradient.addColour (0.8,  juce::Colours::orange);
+
+        for (size_t i = 0; i < colours.size(); ++i)
+            colours[i] = gradient.getColourAtPosition ((double) i / (double) (colours.size() - 1));
+
+        startTimerHz (30);
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        g.fillAll (juce::Colours::black);
+
+        if (spectrogram.isValid())
+        {
+            auto area = getSpectrogramArea();
+            auto width = spectrogram.getWidth(), height = spectrogram.getHeight();
+            auto older = width - writeColumn;
+
+            g.drawImage (spectrogram, area.getX(), area.getY(), older, height, writeColumn, 0, older, height);
+
+            if (writeColumn > 0)
+                g.drawImage (spectrogram, area.getX() + older, area.getY(), writeColumn, height, 0, 0, writeColumn, height);
+        }
+
+        auto scopeArea = getScopeArea().toFloat();
+        g.setColour (juce::Colours::darkgrey);
+        g.drawRect (scopeArea);
+        g.drawHorizontalLine (juce::roundToInt (scopeArea.getCentreY()), scopeArea.getX(), scopeArea.getRight());
+
+        // the first rising zero crossing in the older half of the history, if there is one
+        auto start = 0;
+
+        for (int i = 1; i < scopeLength; ++i)
+        {
+            if (scopeHistory[(size_t) i - 1] < 0.0f && scopeHistory[(size_t) i] >= 0.0f)
+            {
+                start = i;
+                break;
+            }
+        }
+
+        scopePath.clear();
+
+        for (int i = 0; i < scopeLength; ++i)
+        {
+            auto x = scopeArea.getX() + scopeArea.getWidth() * (float) i / (float) (scopeLength - 1);
+            auto y = scopeArea.getCentreY() - 0.5f * scopeArea.getHeight() * juce::jlimit (-1.0f, 1.0f, scopeHistory[(size_t) (start + i)]);
+
+            if (i == 0)
+                scopePath.startNewSubPath (x, y);
+            else
+                scopePath.lineTo (x, y);
+        }
+
+        g.setColour (juce::Colours::lightgreen);
+        g.strokePath (scopePath, juce::PathStrokeType (1.0f));
+    }
+
+    void resized() override
+    {
+        auto area = getSpectrogramArea();
+
+        if (area.isEmpty())
+            spectrogram = juce::Image();
+        else
+            spectrogram = juce::Image (juce::Image::RGB, area.getWidth(), area.getHeight(), true);
+
+        writeColumn = 0;
+        updateRows();
+    }
+
+private:
+    void timerCallback() override
+    {
+        if (analyser.getSampleRate() != rowsSampleRate)
+            updateRows();
+
+        auto numScopeSamples = analyser.popScope (scopeScratch.data(), (int) scopeScratch.size());
+        appendToScope (numScopeSamples);
+
+        auto changed = numScopeSamples > 0;
+
+        while (analyser.popColumn (column.data()))
+        {
+            drawColumn();
+            changed = true;
+        }
+
+        if (changed)
+            repaint();
+    }
+
+    juce::Rectangle<int> getSpectrogramArea() const         { return getLocalBounds().withWidth (getWidth() * 7 / 10); }
+    juce::Rectangle<int> getScopeArea() const               { return getLocalBounds().withTrimmedLeft (getWidth() * 7 / 10 + 10); }
+
+    // the range of bins of each row of the image, from minFrequency at the bottom to Nyquist at the top.
+    void updateRows()
+    {
+        rowsSampleRate = analyser.getSampleRate();
+        auto height = spectrogram.isValid() ? spectrogram.getHeight() : 0;
+        auto binsPerHz = (float) SpectrogramAnalyser::fftSize / (float) rowsSampleRate;
+        auto lastBin = (int) analyser.getNumBins() - 1;
+        auto ratio = (float) (0.5 * rowsSampleRate) / minFrequency;
+
+        firstBins.resize ((size_t) height);
+        lastBins.resize ((size_t) height);
+
+        for (int y = 0; y < height; ++y)
+        {
+            auto low  = minFrequency * std::pow (ratio, (float) (height - 1 - y) / (float) height);
+            auto high = minFrequency * std::pow (ratio, (float) (height - y) / (float) height);
+
+            firstBins[(size_t) y] = juce::jlimit (0, lastBin, juce::roundToInt (low * binsPerHz));
+            lastBins[(size_t) y]  = juce::jlimit (firstBins[(size_t) y], lastBin, juce::roundToInt (high * binsPerHz));
+        }
+    }
+
+    void drawColumn()
+    {
+        if (! spectrogram.isValid())
+            return;
+
+        auto height = spectrogram.getHeight();
+        juce::Image::BitmapData pixels (spectrogram, writeColumn, 0, 1, height, juce::Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+        {
+            auto level = minDecibels;
+
+            for (auto k = firstBins[(size_t) y]; k <= lastBins[(size_t) y]; ++k)
+                level = juce::jmax (level, column[(size_t) k]);
+
+            auto position = juce::jlimit (0.0f, 1.0f, 1.0f - level / minDecibels);
+            pixels.setPixelColour (0, y, colours[(size_t) juce::roundToInt (position * (float) (colours.size() - 1))]);
+        }
+
+        writeColumn = (writeColumn + 1) % spectrogram.getWidth();
+    }
+
+    // keep the newest 2 * scopeLength samples, oldest first.
+    void appendToScope (int numSamples)
+    {
+        auto size = (int) scopeHistory.size();
+        auto numNew = juce::jmin (numSamples, size);
+        auto* newest = scopeScratch.data() + (numSamples - numNew);
+
+        std::copy (scopeHistory.begin() + numNew, scopeHistory.end(), scopeHistory.begin());
+        std::copy_n (newest, numNew, scopeHistory.data() + (size - numNew));
+    }
+
+    SpectrogramAnalyser& analyser;
+
+    juce::Image spectrogram;
+    int writeColumn = 0;
+    std::vector<float> column;
+    std::vector<int> firstBins, lastBins;
+    double rowsSampleRate = 0.0;
+    std::array<juce::Colour, 256> colours;
+
+    std::vector<float> scopeHistory, scopeScratch;
+    juce::Path scopePath;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrogramComponent)
+};
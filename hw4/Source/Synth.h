@@ -11,38 +11,262 @@
 #pragma once
 #define PI        3.14159265358979323846264338327950288
 
+#include "Oscillator.h"
+#include "Envelope.h"
+#include "ParameterStore.h"
+#include "VoiceAllocator.h"
+#include "RenderThreadPool.h"
+#include "DelayLine.h"
+#include "LFO.h"
+#include "MultiTapDelay.h"
+#include "CrossFeedbackDelay.h"
+#include "EffectGraph.h"
+#include "Convolution.h"
+#include "FDNReverb.h"
+#include "STFT.h"
+
 //==============================================================================
-template <typename Type>
-class DelayLine
+enum class EffectType { none, delay, chorus, flanger, multiTap, crossFeedback };
+
+// the effect type of a name shown in the GUI and taken by the offline renderer; unknown names give none.
+inline EffectType getEffectType (const juce::String& name)
 {
-public:
-    void clear() noexcept
+    if (name == "Delay")          return EffectType::delay;
+    if (name == "Chorus")         return EffectType::chorus;
+    if (name == "Flanger")        return EffectType::flanger;
+    if (name == "MultiTap")       return EffectType::multiTap;
+    if (name == "CrossFeedback")  return EffectType::crossFeedback;
+    return EffectType::none;
+}
+
+//==============================================================================
+// parameters and delay lines shared by every effect type. Effect::process() ramps changed
+// parameters across a block in short steps and calls the effect once per step. delayTimes is
+// the delay at the end of a step and previousDelayTimes the delay at its start; reading both
+// and fading from one to the other (DelayLine::readCrossfaded) changes the delay without a
+// click or a pitch glide.
+template <typename Type, size_t maxNumChannels>
+struct EffectState
+{
+    std::array<DelayLine<Type>, maxNumChannels> delayLines;
+    std::array<Type, maxNumChannels> delayTimes;
+    std::array<Type, maxNumChannels> previousDelayTimes;
+    Type feedback { Type (0) };
+    Type wetDry { Type (0) };
+
+    Type sampleRate   { Type (48000) };
+    Type maxDelayTime { Type (2.0f) };
+
+    float maxDelaySample = (float)(sampleRate*maxDelayTime);
+
+    float LFORate = 0.0f;
+    float LFODepth = 0.0f;
+    float LFOPhase[maxNumChannels] = {};
+    float LFOPhaseIncrement = 0.0f;
+
+    size_t readPointer;
+    size_t staticReadPointer;
+    size_t variableReadPointer;
+    size_t writePointer[maxNumChannels] = {};
+
+    // the LFO of each channel for the current block, at LFORate, from state.lfo.getOutput (ch);
+    // it is generated before each call of an effect whose usesLFO is true.
+    LFOBank<maxNumChannels> lfo;
+
+    MultiTapDelay<Type, maxNumChannels> taps;
+    CrossFeedbackDelay<Type, maxNumChannels> crossFeedback;
+};
+
+//==============================================================================
+// Each effect type is a policy class with a static process() over a whole block. Effect
+// holds one of them in a variant chosen by setFXType(), so the audio thread makes a single
+// jump per block and then runs a loop compiled for that effect alone. The Delay, Chorus and
+// Flanger policies are the homework and loop over the channels one by one; the channels of
+// a frame are processed together in SIMD lanes by CrossFeedbackEffect, which with an identity
+// matrix (Effect::setFeedbackMatrix) is the same feedback delay on every channel.
+struct NoEffect
+{
+    static constexpr bool usesLFO = false;
+
+    template <typename State, typename InputBlock, typename OutputBlock>
+    static void process (State&, const InputBlock&, OutputBlock&) noexcept {}
+};
+
+//==============================================================================
+// a simple feedback delay.
+struct DelayEffect
+{
+    static constexpr bool usesLFO = false;
+
+    template <typename State, typename InputBlock, typename OutputBlock>
+    static void process (State& state, const InputBlock& inputBlock, OutputBlock& outputBlock) noexcept
     {
-        std::fill (rawData.begin(), rawData.end(), Type (0));
+        auto numSamples  = outputBlock.getNumSamples();
+        auto numChannels = outputBlock.getNumChannels();
+
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Problem #1 ////////////////////////////////////////////////////////////////////////////////////////////////
+        // Modify this block to implement a simple delay effect.  ////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* input  = inputBlock .getChannelPointer (ch);
+            auto* output = outputBlock.getChannelPointer (ch);
+            auto& dline = state.delayLines[ch];
+            auto delayTimeSamples = (float)(state.delayTimes[ch]*state.sampleRate);
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                float outputPointer;
+                state.readPointer = 0;
+                float readPointerFrac;
+                float tapOut;
+                auto inputSample = input[i];
+                dline.push (state.writePointer[ch], 0);
+
+                auto outputSample = state.wetDry*inputSample;
+                if (outputSample > 1) {outputSample = 1.0f;}
+                output[i] = outputSample;
+            }
+        }
+
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Problem #1 END ////////////////////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
     }
+};
+
+//==============================================================================
+// a chorus: the delay time swings around the set time with the LFO.
+struct ChorusEffect
+{
+    // set to true once process() reads state.lfo, so that it is generated for each call
+    static constexpr bool usesLFO = false;
 
-    size_t size() const noexcept
+    template <typename State, typename InputBlock, typename OutputBlock>
+    static void process (State& state, const InputBlock& inputBlock, OutputBlock& outputBlock) noexcept
     {
-        return rawData.size();
+        auto numSamples  = outputBlock.getNumSamples();
+        auto numChannels = outputBlock.getNumChannels();
+
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Problem #2 ////////////////////////////////////////////////////////////////////////////////////////////////
+        // Modify this block to implement a chorus effect.  //////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* input  = inputBlock .getChannelPointer (ch);
+            auto* output = outputBlock.getChannelPointer (ch);
+            auto& dline = state.delayLines[ch];
+            auto delayTimeSamples = (float)(state.delayTimes[ch]*state.sampleRate);
+            
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                state.LFOPhase[ch] = 0.0f;
+                float LFOOut;
+                float outputPointer;
+                state.readPointer = 0;
+                float readPointerFrac;
+                float tapOut;
+                auto inputSample = input[i];
+                dline.push (state.writePointer[ch], 0);
+                state.writePointer[ch] = dline.wrap (state.writePointer[ch] + 1);
+
+                auto outputSample = state.wetDry*inputSample;
+                if (outputSample > 1) {outputSample = 1.0f;}
+                output[i] = outputSample;
+            }
+        }
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Problem #2 END ////////////////////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
     }
+};
+
+//==============================================================================
+// a flanger: a short static tap mixed with a tap swept by the LFO.
+struct FlangerEffect
+{
+    // set to true once process() reads state.lfo, so that it is generated for each call
+    static constexpr bool usesLFO = false;
 
-    void resize (size_t newValue)
+    template <typename State, typename InputBlock, typename OutputBlock>
+    static void process (State& state, const InputBlock& inputBlock, OutputBlock& outputBlock) noexcept
     {
-        rawData.resize (newValue);
+        auto numSamples  = outputBlock.getNumSamples();
+        auto numChannels = outputBlock.getNumChannels();
+
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Problem #3 ////////////////////////////////////////////////////////////////////////////////////////////////
+        // Modify this block to implement a flanger effect.  /////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* input  = inputBlock .getChannelPointer (ch);
+            auto* output = outputBlock.getChannelPointer (ch);
+            auto& dline = state.delayLines[ch];
+            auto delayTimeSamples = (float)(state.delayTimes[ch]*state.sampleRate);
+            auto variableDelayTimeSamples = (float)((state.delayTimes[ch]*1.125f)*state.sampleRate);
+            
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                state.LFOPhase[ch] = 0.0f;
+                float LFOOut;
+                float staticOutputPointer = 0;
+                float staticReadPointerFrac;
+                float staticTapOut;
+                float variableOutputPointer;
+                float variableReadPointerFrac;
+                float variableTapOut;
+                float tapOut;
+                auto inputSample = input[i];
+                dline.push (state.writePointer[ch], 0);
+
+                auto outputSample = state.wetDry*inputSample;
+                if (outputSample > 1) {outputSample = 1.0f;}
+                output[i] = outputSample;
+            }
+        }
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Problem #3 END ////////////////////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
     }
+};
+
+//==============================================================================
+// up to 32 taps with their own gain, pan and lowpass, all read from the delay lines of the state.
+struct MultiTapEffect
+{
+    static constexpr bool usesLFO = false;
 
-    Type get (size_t readPointer) const noexcept
+    template <typename State, typename InputBlock, typename OutputBlock>
+    static void process (State& state, const InputBlock& inputBlock, OutputBlock& outputBlock) noexcept
     {
-        return rawData[readPointer];
+        state.taps.process (state.delayLines.data(), state.writePointer, inputBlock, outputBlock, state.wetDry);
     }
+};
+
+//==============================================================================
+// a delay whose repeats are fed back between the channels through a matrix, by default a
+// ping-pong; it uses the delay times, feedback and wet/dry of the state.
+struct CrossFeedbackEffect
+{
+    static constexpr bool usesLFO = false;
 
-    void push (size_t writePointer, Type valueToAdd) noexcept
+    template <typename State, typename InputBlock, typename OutputBlock>
+    static void process (State& state, const InputBlock& inputBlock, OutputBlock& outputBlock) noexcept
     {
-        rawData[writePointer] = valueToAdd;
-    }
+        constexpr auto numChannels = std::tuple_size<decltype (state.delayTimes)>::value;
+        std::array<size_t, numChannels> from, to;
 
-private:
-    std::vector<Type> rawData;
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            from[ch] = (size_t) std::lround (state.previousDelayTimes[ch] * state.sampleRate);
+            to[ch]   = (size_t) std::lround (state.delayTimes[ch] * state.sampleRate);
+        }
+
+        state.crossFeedback.process (inputBlock, outputBlock, from.data(), to.data(), state.feedback, state.wetDry);
+    }
 };
 
 //==============================================================================
@@ -50,6 +274,9 @@ template <typename Type, size_t maxNumChannels = 2>
 class Effect
 {
 public:
+    // up to 16 channels, e.g. for surround or for several buses rendered together
+    static_assert (maxNumChannels >= 1 && maxNumChannels <= 16, "Effect supports 1 to 16 channels");
+
     Effect()
     {
         setMaxDelayTime (2.0f);
@@ -58,12 +285,16 @@ public:
         setFeedback (0.5f);
         setLFORate (2.0f);
         setLFODepth (0.01f);
+        targets.sampleRate.store (state.sampleRate, std::memory_order_relaxed);
+        state.lfo.prepare ((double) state.sampleRate, 512);
+        jumpToTargets();
     }
 
     void prepare (const juce::dsp::ProcessSpec& spec)
     {
         jassert (spec.numChannels <= maxNumChannels);
-        sampleRate = (Type) spec.sampleRate;
+        setSampleRate ((Type) spec.sampleRate);
+        state.lfo.prepare (spec.sampleRate, juce::jmax ((size_t) spec.maximumBlockSize, rampStepSamples));
         updateDelayLineSize();
     }
 
@@ -71,41 +302,54 @@ public:
     {
         for (size_t ch = 0; ch < getNumChannels(); ++ch)
         {
-            delayLines[ch].clear();
-            writePointer[ch] = 0;
+            state.delayLines[ch].clear();
+            state.writePointer[ch] = 0;
         }
+
+        state.taps.reset();
+        state.crossFeedback.clear();
+        state.lfo.reset();
+        jumpToTargets();
     }
 
     size_t getNumChannels() const noexcept
     {
-        return delayLines.size();
+        return state.delayLines.size();
     }
 
+    // recomputes the filters of the taps, so like setTap() call it from the audio thread or
+    // while it is locked out. The LFOs take the new rate at the start of the next block.
     void setSampleRate(Type newValue)
     {
-        sampleRate = newValue;
-        maxDelaySample = (float)(sampleRate*maxDelayTime);
-        LFOPhaseIncrement = 2.0f*PI*LFORate/sampleRate;
+        state.sampleRate = newValue;
+        state.maxDelaySample = (float)(state.sampleRate*state.maxDelayTime);
+        state.LFOPhaseIncrement = 2.0f*PI*state.LFORate/state.sampleRate;
+        state.taps.setSampleRate (newValue);
+        targets.sampleRate.store (newValue, std::memory_order_relaxed);
     }
 
+    // The setters below only store the new value, so they are cheap and safe to call from
+    // any thread while the audio thread runs process(), which ramps to the value over its
+    // next block. The delay lines are never cleared by a parameter change.
+
     void setMaxDelayTime (Type newValue)
     {
         jassert (newValue > Type (0));
-        maxDelayTime = newValue;
+        state.maxDelayTime = newValue;
         updateDelayLineSize();
-        maxDelaySample = (float)(sampleRate*maxDelayTime);
+        state.maxDelaySample = (float)(state.sampleRate*state.maxDelayTime);
     }
 
     void setFeedback (Type newValue) noexcept
     {
         jassert (newValue >= Type (0) && newValue <= Type (1));
-        feedback = newValue;
+        targets.feedback.store (newValue, std::memory_order_relaxed);
     }
 
     void setWetDry (Type newValue) noexcept
     {
         jassert (newValue >= Type (0) && newValue <= Type (1));
-        wetDry = newValue;
+        targets.wetDry.store (newValue, std::memory_order_relaxed);
     }
 
     void setDelayTime (size_t channel, Type newValue)
@@ -117,7 +361,7 @@ public:
         }
 
         jassert (newValue >= Type (0));
-        delayTimes[channel] = newValue;
+        targets.delayTimes[channel].store (newValue, std::memory_order_relaxed);
     }
     
     void setDelayTimes (Type newValue)
@@ -125,178 +369,182 @@ public:
         for (size_t ch = 0; ch < getNumChannels(); ++ch)
         {
             jassert (newValue >= Type (0));
-            delayTimes[ch] = newValue;
+            targets.delayTimes[ch].store (newValue, std::memory_order_relaxed);
         }
     }
 
     void setLFORate (Type newValue)
     {
-        LFORate = newValue;
-        LFOPhaseIncrement = 2.0f*PI*LFORate/sampleRate;
+        targets.LFORate.store (newValue, std::memory_order_relaxed);
     }
 
     void setLFODepth (Type newValue)
     {
-        LFODepth = newValue;
+        targets.LFODepth.store (newValue, std::memory_order_relaxed);
+    }
+
+    // the taps of the multi-tap mode. Unlike the setters above these take effect at once, so
+    // call them from the audio thread or while it is locked out.
+    void setNumTaps (size_t newValue) noexcept                      { state.taps.setNumTaps (newValue); }
+    void setTap (size_t index, const DelayTap& newValue) noexcept   { state.taps.setTap (index, newValue); }
+
+    // the feedback matrix of the cross-feedback mode, scaled by the feedback gain; it takes
+    // effect at once, like the taps.
+    void setFeedbackMatrix (const typename CrossFeedbackDelay<Type, maxNumChannels>::Matrix& newValue) noexcept
+    {
+        state.crossFeedback.setMatrix (newValue);
     }
 
-    void setFXType (juce::String newValue)
+    // the LFO shape of the modulated types, and the phase offset of a channel's LFO in cycles.
+    void setLFOShape (LFOShape newValue) noexcept                   { state.lfo.setShape (newValue); }
+    void setLFOPhaseOffset (size_t channel, double cycles) noexcept { state.lfo.setPhaseOffset (channel, cycles); }
+
+    void setFXType (EffectType newValue)
     {
         this->reset();
-        FXType = newValue;
+        type = newValue;
+
+        switch (newValue)
+        {
+            case EffectType::delay:         effect = DelayEffect();          break;
+            case EffectType::chorus:        effect = ChorusEffect();         break;
+            case EffectType::flanger:       effect = FlangerEffect();        break;
+            case EffectType::multiTap:      effect = MultiTapEffect();       break;
+            case EffectType::crossFeedback: effect = CrossFeedbackEffect();  break;
+            case EffectType::none:
+            default:                        effect = NoEffect();             break;
+        }
     }
 
+    void setFXType (const juce::String& newValue)   { setFXType (getEffectType (newValue)); }
+
+    EffectType getFXType() const noexcept           { return type; }
+
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
     {
         auto& inputBlock  = context.getInputBlock();
         auto& outputBlock = context.getOutputBlock();
-        auto numSamples  = outputBlock.getNumSamples();
-        auto numChannels = outputBlock.getNumChannels();
+
+        auto numSamples = outputBlock.getNumSamples();
 
         jassert (inputBlock.getNumSamples() == numSamples);
-        jassert (inputBlock.getNumChannels() == numChannels);
-      
-        if (delayTimes[0] > 0)
-        {
-            if (FXType == "Delay")
-            {
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                // Problem #1 ////////////////////////////////////////////////////////////////////////////////////////////////
-                // Modify this block to implement a simple delay effect.  ////////////////////////////////////////////////////
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                for (size_t ch = 0; ch < numChannels; ++ch)
-                {
-                    auto* input  = inputBlock .getChannelPointer (ch);
-                    auto* output = outputBlock.getChannelPointer (ch);
-                    auto& dline = delayLines[ch];
-                    auto delayTimeSamples = (float)(delayTimes[ch]*sampleRate);
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
 
-                    for (size_t i = 0; i < numSamples; ++i)
-                    {
-                        float outputPointer;
-                        readPointer = 0;
-                        float readPointerFrac;
-                        float tapOut;
-                        auto inputSample = input[i];
-                        dline.push (writePointer[ch], 0);
-
-                        auto outputSample = wetDry*inputSample;
-                        if (outputSample > 1) {outputSample = 1.0f;}
-                        output[i] = outputSample;
-                    }
-                }
+        auto sampleRate = (double) targets.sampleRate.load (std::memory_order_relaxed);
 
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                // Problem #1 END ////////////////////////////////////////////////////////////////////////////////////////////
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            }
-            else if (FXType == "Chorus")
-            {
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                // Problem #2 ////////////////////////////////////////////////////////////////////////////////////////////////
-                // Modify this block to implement a chorus effect.  //////////////////////////////////////////////////////////
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                for (size_t ch = 0; ch < numChannels; ++ch)
-                {
-                    auto* input  = inputBlock .getChannelPointer (ch);
-                    auto* output = outputBlock.getChannelPointer (ch);
-                    auto& dline = delayLines[ch];
-                    auto delayTimeSamples = (float)(delayTimes[ch]*sampleRate);
-                    
-                    for (size_t i = 0; i < numSamples; ++i)
-                    {
-                        LFOPhase[ch] = 0.0f;
-                        float LFOOut;
-                        float outputPointer;
-                        readPointer = 0;
-                        float readPointerFrac;
-                        float tapOut;
-                        auto inputSample = input[i];
-                        dline.push (writePointer[ch], 0);
-                        writePointer[ch] = writePointer[ch] + 1;
-                        if (writePointer[ch] >= maxDelaySample)
-                        {
-                            writePointer[ch] = 0;
-                        }
-
-                        auto outputSample = wetDry*inputSample;
-                        if (outputSample > 1) {outputSample = 1.0f;}
-                        output[i] = outputSample;
-                    }
-                }
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                // Problem #2 END ////////////////////////////////////////////////////////////////////////////////////////////
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            }
-            else if (FXType == "Flanger")
+        if (sampleRate != state.lfo.getSampleRate())
+            state.lfo.setSampleRate (sampleRate);
+
+        auto from = getCurrentParameters(), to = getTargetParameters();
+        // an unchanged block is a single step, unless it is longer than the LFO buffers
+        auto stepSize = from == to ? state.lfo.getMaxBlockSize() : rampStepSamples;
+        auto numSteps = juce::jmax ((size_t) 1, (numSamples + stepSize - 1) / stepSize);
+
+        for (size_t step = 0; step < numSteps; ++step)
+        {
+            auto start = numSamples * step / numSteps, end = numSamples * (step + 1) / numSteps;
+            setCurrentParameters (from, to, (Type) (step + 1) / (Type) numSteps);
+
+            // the taps have delays of their own
+            if (state.delayTimes[0] > 0 || type == EffectType::multiTap)
             {
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                // Problem #3 ////////////////////////////////////////////////////////////////////////////////////////////////
-                // Modify this block to implement a flanger effect.  /////////////////////////////////////////////////////////
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                for (size_t ch = 0; ch < numChannels; ++ch)
+                auto input  = inputBlock .getSubBlock (start, end - start);
+                auto output = outputBlock.getSubBlock (start, end - start);
+                std::visit ([&] (auto& e)
                 {
-                    auto* input  = inputBlock .getChannelPointer (ch);
-                    auto* output = outputBlock.getChannelPointer (ch);
-                    auto& dline = delayLines[ch];
-                    auto delayTimeSamples = (float)(delayTimes[ch]*sampleRate);
-                    auto variableDelayTimeSamples = (float)((delayTimes[ch]*1.125f)*sampleRate);
-                    
-                    for (size_t i = 0; i < numSamples; ++i)
-                    {
-                        LFOPhase[ch] = 0.0f;
-                        float LFOOut;
-                        float staticOutputPointer = 0;
-                        float staticReadPointerFrac;
-                        float staticTapOut;
-                        float variableOutputPointer;
-                        float variableReadPointerFrac;
-                        float variableTapOut;
-                        float tapOut;
-                        auto inputSample = input[i];
-                        dline.push (writePointer[ch], 0);
-
-                        auto outputSample = wetDry*inputSample;
-                        if (outputSample > 1) {outputSample = 1.0f;}
-                        output[i] = outputSample;
-                    }
-                }
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                // Problem #3 END ////////////////////////////////////////////////////////////////////////////////////////////
-                //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+                    if constexpr (std::decay_t<decltype (e)>::usesLFO)
+                        state.lfo.generate (end - start);
+
+                    e.process (state, input, output);
+                }, effect);
             }
         }
     }
+
+    // length of the steps in which a parameter change is ramped across a block.
+    static constexpr size_t rampStepSamples = 32;
+
 private:
-    std::array<DelayLine<Type>, maxNumChannels> delayLines;
-    std::array<Type, maxNumChannels> delayTimes;
-    Type feedback { Type (0) };
-    Type wetDry { Type (0) };
+    // the parameters that are ramped, as a set.
+    struct Parameters
+    {
+        std::array<Type, maxNumChannels> delayTimes;
+        Type feedback, wetDry, LFORate, LFODepth;
 
-    Type sampleRate   { Type (48000) };
-    Type maxDelayTime { Type (2.0f) };
+        bool operator== (const Parameters& other) const noexcept
+        {
+            return delayTimes == other.delayTimes && feedback == other.feedback && wetDry == other.wetDry
+                    && LFORate == other.LFORate && LFODepth == other.LFODepth;
+        }
+    };
 
-    float maxDelaySample = (float)(sampleRate*maxDelayTime);
+    Parameters getCurrentParameters() const noexcept
+    {
+        return { state.delayTimes, state.feedback, state.wetDry, (Type) state.LFORate, (Type) state.LFODepth };
+    }
+
+    Parameters getTargetParameters() const noexcept
+    {
+        Parameters p;
+
+        for (size_t ch = 0; ch < maxNumChannels; ++ch)
+            p.delayTimes[ch] = targets.delayTimes[ch].load (std::memory_order_relaxed);
+
+        p.feedback = targets.feedback.load (std::memory_order_relaxed);
+        p.wetDry   = targets.wetDry  .load (std::memory_order_relaxed);
+        p.LFORate  = targets.LFORate .load (std::memory_order_relaxed);
+        p.LFODepth = targets.LFODepth.load (std::memory_order_relaxed);
+        return p;
+    }
+
+    // set the state a fraction alpha of the way from one parameter set to the other.
+    void setCurrentParameters (const Parameters& from, const Parameters& to, Type alpha) noexcept
+    {
+        auto mix = [alpha] (Type a, Type b) { return a + alpha * (b - a); };
+
+        state.previousDelayTimes = state.delayTimes;
+
+        for (size_t ch = 0; ch < maxNumChannels; ++ch)
+            state.delayTimes[ch] = mix (from.delayTimes[ch], to.delayTimes[ch]);
+
+        state.feedback = mix (from.feedback, to.feedback);
+        state.wetDry   = mix (from.wetDry, to.wetDry);
+        state.LFORate  = (float) mix (from.LFORate, to.LFORate);
+        state.LFODepth = (float) mix (from.LFODepth, to.LFODepth);
+        state.LFOPhaseIncrement = 2.0f*PI*state.LFORate/state.sampleRate;
+        state.lfo.setFrequency ((double) state.LFORate);
+    }
+
+    // take the set values at once, without a ramp.
+    void jumpToTargets() noexcept
+    {
+        auto to = getTargetParameters();
+        setCurrentParameters (to, to, Type (1));
+        state.previousDelayTimes = state.delayTimes;
+    }
 
     void updateDelayLineSize()
     {
-        auto delayLineSizeSamples = (size_t) std::ceil (maxDelayTime * sampleRate);
-        for (auto& dline : delayLines)
+        auto delayLineSizeSamples = (size_t) std::ceil (state.maxDelayTime * state.sampleRate);
+        for (auto& dline : state.delayLines)
             dline.resize (delayLineSizeSamples);
-    }
 
-    float LFORate = 0.0f;
-    float LFODepth = 0.0f;
-    float LFOPhase[2] = {};
-    float LFOPhaseIncrement = 0.0f;
+        state.crossFeedback.resize (delayLineSizeSamples);
+    }
 
-    juce::String FXType = "None";
-    
-    size_t readPointer;
-    size_t staticReadPointer;
-    size_t variableReadPointer;
-    size_t writePointer[2] = {0, 0};
+    // the values given to the setters, from whichever thread calls them.
+    struct Targets
+    {
+        std::array<std::atomic<Type>, maxNumChannels> delayTimes;
+        std::atomic<Type> feedback { Type (0) }, wetDry { Type (0) }, LFORate { Type (0) }, LFODepth { Type (0) };
+        std::atomic<Type> sampleRate { Type (48000) };
+    };
+
+    EffectState<Type, maxNumChannels> state;
+    Targets targets;
+    std::variant<NoEffect, DelayEffect, ChorusEffect, FlangerEffect, MultiTapEffect, CrossFeedbackEffect> effect;
+    EffectType type = EffectType::none;
 };
 
 //==============================================================================
@@ -308,10 +556,38 @@ struct SineWaveSound   : public juce::SynthesiserSound
     bool appliesToChannel (int) override        { return true; }
 };
 
+//==============================================================================
+// carrier and modulator parameters of the FM voice, shared by the GUI and the offline tools.
+struct FMParameters
+{
+    float carrierAmplitude      = 1.0f;
+    float carrierAttackTime     = 0.0f;
+    float carrierDecayTime      = 0.01f;
+    float carrierSustainLevel   = 1.0f;
+    float carrierReleaseTime    = 0.01f;
+
+    float modulatorAmplitude    = 0.0f;
+    float modulatorFreqRatio    = 1.0f;
+    float modulatorAttackTime   = 0.0f;
+    float modulatorDecayTime    = 0.01f;
+    float modulatorSustainLevel = 1.0f;
+    float modulatorReleaseTime  = 0.01f;
+
+    ADSRTimes getCarrierTimes() const noexcept
+    {
+        return { carrierAttackTime, carrierDecayTime, carrierSustainLevel, carrierReleaseTime };
+    }
+
+    ADSRTimes getModulatorTimes() const noexcept
+    {
+        return { modulatorAttackTime, modulatorDecayTime, modulatorSustainLevel, modulatorReleaseTime };
+    }
+};
+
 //==============================================================================
 struct FMVoice   : public juce::SynthesiserVoice
 {
-    FMVoice() {}
+    FMVoice() : sineTable (DefaultSineTable::getInstance()) {}
 
     bool canPlaySound (juce::SynthesiserSound* sound) override
     {
@@ -321,102 +597,55 @@ struct FMVoice   : public juce::SynthesiserVoice
     void startNote (int midiNoteNumber, float velocity,
                     juce::SynthesiserSound*, int /*currentPitchWheelPosition*/) override
     {
-        currentAngle = 0.0;
-        tailOff = 0.0;
+        carrier.reset();
+        modulator.reset();
         level = velocity * 0.15;
-        currentTime = 0.0;
-        auto cyclesPerSecond = juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber);
-        auto cyclesPerSample = cyclesPerSecond / getSampleRate();
-        angleDelta = cyclesPerSample * 2.0 * juce::MathConstants<double>::pi;
+        carrier.setFrequency (juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber), getSampleRate());
+
+        for (auto* envelope : { &carrierEnvelope, &modulatorEnvelope })
+        {
+            envelope->setSampleRate (getSampleRate());
+            envelope->noteOn();
+        }
     }
 
     void stopNote (float /*velocity*/, bool allowTailOff) override
     {
         if (allowTailOff)
         {
-            if (tailOff == 0.0){
-                tailOff = 1.0;
-                currentTime = 0.0;
-            }
+            carrierEnvelope.noteOff();
+            modulatorEnvelope.noteOff();
         }
         else
         {
             clearCurrentNote();
-            angleDelta = 0.0;
+            carrier.increment = 0;
+            carrierEnvelope.reset();
+            modulatorEnvelope.reset();
         }
     }
 
     void pitchWheelMoved (int) override      {}
     void controllerMoved (int, int) override {}
 
-    
-    // get ADSR curve for carrier or modulator from current time and ADSR parameter.
-    float getADSRCurve( float attackTime, float decayTime,
-                        float sustainLevel, float releaseTime,
-                        bool isRelease, float currentLevel
-    )
-    {
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        // Problem #0 ////////////////////////////////////////////////////////////////////////////////////////////////
-        // Replace this block with your Homework #3 solution. ////////////////////////////////////////////////////////
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        if ( !isRelease )
-        {
-            if (( currentTime < attackTime) && ( attackTime > 0 ))
-            {
-                return 1.0f; 
-            }
-            else if (( currentTime > attackTime) && ( currentTime - attackTime < decayTime )) 
-            {
-                return 1.0f;
-            }
-            else
-            {
-                return 1.0f;
-            } 
-        }
-        else
-        {
-            if ( currentTime < releaseTime )
-            {
-                return 0.0f;
-            }
-            else
-            {
-                return 0.0f;
-            }
-        }
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    }
-    
-    // get current sample from current angle, sample and carrier and modulator parameters.
-    float getCurrentSample (    float carrierAmplitude,
-                                float carrierAttackTime, float carrierDecayTime,
-                                float carrierSustainLevel, float carrierReleaseTime,
-                                float modulatorAmplitude, float modulatorFreqRatio,
-                                float modulatorAttackTime, float modulatorDecayTime,
-                                float modulatorSustainLevel, float modulatorReleaseTime,
-                                bool isRelease
-    )
+    // get current sample from carrier and modulator amplitudes, advancing both oscillators and envelopes by one sample.
+    float getCurrentSample (float carrierAmplitude, float modulatorAmplitude)
     {
         //////////////////////////////////////////////////////////////////////////////////////////////////////////////
         // Problem #0 ////////////////////////////////////////////////////////////////////////////////////////////////
         // Replace this block with your Homework #3 solution. ////////////////////////////////////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        float carrierADSR = 1.0f;
-        float modulatorADSR = 1.0f;
-        
-        if ( !isRelease )
-        {
-            currentCarrierLevel = carrierADSR;
-            currentModulatorLevel = modulatorADSR;
-        }
+        float carrierADSR = carrierEnvelope.getNextSample();
+        float modulatorADSR = modulatorEnvelope.getNextSample();
+
         float carAmp = carrierAmplitude * carrierADSR;
         float modAmp = modulatorAmplitude * modulatorADSR;
-        
-        return (float) ( std::sin (currentAngle) );
+
+        auto modulatorPhase = modulator.advance();
+        auto carrierPhase   = carrier.advance();
+        auto modulation     = modAmp * sineTable.lookup (modulatorPhase);
+
+        return carAmp * sineTable.lookup (carrierPhase + Phasor::radiansToPhase (modulation));
         //////////////////////////////////////////////////////////////////////////////////////////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -433,137 +662,761 @@ struct FMVoice   : public juce::SynthesiserVoice
                             float modulatorSustainLevel, float modulatorReleaseTime
     ) 
     {
-        if (angleDelta != 0.0)
+        // set even while idle, so the next note starts its attack with the current times
+        carrierEnvelope.setTimes ({ carrierAttackTime, carrierDecayTime, carrierSustainLevel, carrierReleaseTime });
+        modulatorEnvelope.setTimes ({ modulatorAttackTime, modulatorDecayTime, modulatorSustainLevel, modulatorReleaseTime });
+
+        if (carrier.increment != 0)
         {
-            if (tailOff > 0.0) 
+            // the modulator runs at a fixed ratio of the carrier frequency.
+            modulator.increment = (juce::uint32) (juce::uint64) (carrier.increment * (double) modulatorFreqRatio);
+
+            // samples are collected in the mono scratch array and added to the channels a sub-block at a time
+            while (numSamples > 0)
             {
-                while (--numSamples >= 0)
+                auto numThisTime = juce::jmin (numSamples, maxKernelBlockSize);
+                auto noteEnded = false;
+                int i = 0;
+
+                while (i < numThisTime && ! noteEnded)
                 {
-                    auto currentSample = getCurrentSample(  carrierAmplitude,
-                                                            carrierAttackTime, carrierDecayTime,
-                                                            carrierSustainLevel, carrierReleaseTime,
-                                                            modulatorAmplitude, modulatorFreqRatio,
-                                                            modulatorAttackTime, modulatorDecayTime,
-                                                            modulatorSustainLevel, modulatorReleaseTime,
-                                                            true
-                                                        ) * level;
-                    
-                    for (auto i = outputBuffer.getNumChannels(); --i >= 0;)
-                        outputBuffer.addSample (i, startSample, currentSample);
-
-                    currentAngle += angleDelta;
-                    currentTime  += 1/getSampleRate(); 
-                    ++startSample;
-
-                    if ( carrierReleaseTime < currentTime )
-                    {
-                        clearCurrentNote();
-                        angleDelta = 0.0;
-                        break;
-                    }
+                    samples[(size_t) i++] = (float) (getCurrentSample (carrierAmplitude, modulatorAmplitude) * level);
+
+                    // the note ends with the carrier release
+                    noteEnded = ! carrierEnvelope.isActive();
                 }
-            }
-            else
-            {
-                while (--numSamples >= 0)
+
+                addToChannels (outputBuffer, startSample, i, 1.0f);
+
+                startSample += numThisTime;
+                numSamples  -= numThisTime;
+
+                if (noteEnded)
                 {
-                    auto currentSample = getCurrentSample(  carrierAmplitude,
-                                                            carrierAttackTime, carrierDecayTime,
-                                                            carrierSustainLevel, carrierReleaseTime,
-                                                            modulatorAmplitude, modulatorFreqRatio,
-                                                            modulatorAttackTime, modulatorDecayTime,
-                                                            modulatorSustainLevel, modulatorReleaseTime,
-                                                            false
-                                                        ) * level;
-
-                    for (auto i = outputBuffer.getNumChannels(); --i >= 0;)
-                        outputBuffer.addSample (i, startSample, currentSample);
-
-                    currentAngle += angleDelta;
-                    currentTime  += 1/getSampleRate(); 
-                    ++startSample;
+                    clearCurrentNote();
+                    carrier.increment = 0;
+                    break;
                 }
             }
         }
     }
 
-private:
-    double currentAngle = 0.0, angleDelta = 0.0, level = 0.0, tailOff = 0.0;
-    double currentTime = 0.0, currentCarrierLevel = 0.0, currentModulatorLevel = 0.0;
-};
-
-//==============================================================================
-class FMSynthesizer     : public juce::Synthesiser
-{
-public:
-    void renderVoices (juce::AudioBuffer<float>& buffer, int startSample, int numSamples) override
+    // block counterpart of the per-sample renderNextBlock above. For each sub-block the envelopes and
+    // phases are generated into arrays first, then the FM kernels run over the whole arrays and every
+    // output channel gets one vector multiply-add. Matches the per-sample path to within the sine kernel error.
+    void renderBlock (juce::AudioSampleBuffer& outputBuffer, int startSample, int numSamples, const FMParameters& p)
     {
-        for (auto* voice : voices){
-            FMVoice *fmsynthVoice = dynamic_cast<FMVoice*>(voice);
-            fmsynthVoice->renderNextBlock(  buffer, startSample, numSamples,
-                                            carrierAmplitude,
-                                            carrierAttackTime, carrierDecayTime,
-                                            carrierSustainLevel, carrierReleaseTime,
-                                            modulatorAmplitude, modulatorFreqRatio,
-                                            modulatorAttackTime, modulatorDecayTime,
-                                            modulatorSustainLevel, modulatorReleaseTime
-                                          );
-        }
-        auto block = juce::dsp::AudioBlock<float> (buffer).getSubBlock(startSample, numSamples);
-        auto context = juce::dsp::ProcessContextReplacing<float> (block);
-        if (FXType != "None") { FX.process(context); }
-    }
+        setEnvelopeTimes (p);
 
-    void setCarrierAmplitude(float value)       {this->carrierAmplitude = value;}
-    void setCarrierAttackTime(float value)      {this->carrierAttackTime = value;}
-    void setCarrierDecayTime(float value)       {this->carrierDecayTime = value;}
-    void setCarrierSustainLevel(float value)    {this->carrierSustainLevel = value;}
-    void setCarrierReleaseTime(float value)     {this->carrierReleaseTime = value;}
-    
-    void setModulatorAmplitude(float value)     {this->modulatorAmplitude = value;}
-    void setModulatorFreqRatio(float value)     {this->modulatorFreqRatio = value;}
-    void setModulatorAttackTime(float value)    {this->modulatorAttackTime = value;}
-    void setModulatorDecayTime(float value)     {this->modulatorDecayTime = value;}
-    void setModulatorSustainLevel(float value)  {this->modulatorSustainLevel = value;}
-    void setModulatorReleaseTime(float value)   {this->modulatorReleaseTime = value;}
-
-    void setFXType (juce::String value) {FX.reset(); FX.setFXType(value); this->FXType = value;}
-    void setFeedback (float value)      {FX.reset(); FX.setFeedback(value);}
-    void setDelayTime (float value)     {FX.reset(); FX.setDelayTimes(value);}
-    void setWetDry (float value)        {FX.reset(); FX.setWetDry(value);}
-    void setLFORate (float value)       {FX.reset(); FX.setLFORate(value);}
-    void setLFODepth (float value)      {FX.reset(); FX.setLFODepth(value);}
-    void setSampleRate ()               {FX.setSampleRate(getSampleRate());}
+        if (carrier.increment == 0)
+            return;
 
-private:
-    float carrierAmplitude = 1.0f;
-    float carrierAttackTime = 0.0f;
-    float carrierDecayTime = 0.01f;
-    float carrierSustainLevel = 1.0f;
-    float carrierReleaseTime = 0.01f;
-    
-    float modulatorAmplitude = 0.0f;
-    float modulatorFreqRatio = 1.0f;
-    float modulatorAttackTime = 0.0f;
-    float modulatorDecayTime = 0.01f;
-    float modulatorSustainLevel = 1.0f;
-    float modulatorReleaseTime = 0.01f;
+        modulator.increment = (juce::uint32) (juce::uint64) (carrier.increment * (double) p.modulatorFreqRatio);
 
-    Effect<float> FX;
-    juce::String FXType = "None";
-};
+        while (numSamples > 0)
+        {
+            auto numThisTime = juce::jmin (numSamples, maxKernelBlockSize);
 
+            // once the carrier release is over the rest of the envelope block is silence
+            carrierEnvelope.getNextBlock (carrierLevels.data(), numThisTime);
+            modulatorEnvelope.getNextBlock (modulatorLevels.data(), numThisTime);
+            auto noteEnded = ! carrierEnvelope.isActive();
 
-//==============================================================================
-class SynthAudioSource   :  public juce::AudioSource
-{
-public:
-    SynthAudioSource (juce::MidiKeyboardState& keyState)
-        : keyboardState (keyState)
-    {
-        for (auto i = 0; i < 4; ++i)
-            synth.addVoice (new FMVoice());
+            modulator.advance (modulatorPhases.data(), numThisTime);
+            carrier.advance (carrierPhases.data(), numThisTime);
 
+            sineOfPhases (modulatorPhases.data(), modulation.data(), numThisTime);
+            juce::FloatVectorOperations::multiply (modulation.data(), modulatorLevels.data(), numThisTime);
+            juce::FloatVectorOperations::multiply (modulation.data(), p.modulatorAmplitude, numThisTime);
+            addPhaseOffsets (carrierPhases.data(), modulation.data(), numThisTime);
+
+            sineOfPhases (carrierPhases.data(), samples.data(), numThisTime);
+            juce::FloatVectorOperations::multiply (samples.data(), carrierLevels.data(), numThisTime);
+            addToChannels (outputBuffer, startSample, numThisTime, (float) (p.carrierAmplitude * level));
+
+            startSample += numThisTime;
+            numSamples  -= numThisTime;
+
+            if (noteEnded)
+            {
+                clearCurrentNote();
+                carrier.increment = 0;
+                break;
+            }
+        }
+    }
+
+    // the ADSR times used from the next envelope stage on, including the attack of the next note.
+    void setEnvelopeTimes (const FMParameters& p) noexcept
+    {
+        carrierEnvelope.setTimes (p.getCarrierTimes());
+        modulatorEnvelope.setTimes (p.getModulatorTimes());
+    }
+
+    // constant-power pan of the note, from -1 (left) through 0 (centre, -3 dB) to 1 (right). It applies
+    // to the first two channels of a stereo or wider output; a mono output is never panned.
+    void setPan (float pan) noexcept
+    {
+        // never above unity, so a hard-panned note is no louder in its channel than an unpanned one
+        auto angle = (juce::jlimit (-1.0f, 1.0f, pan) + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+        panGains = { std::cos (angle), std::sin (angle) };
+        panned = true;
+    }
+
+    // send the note to every channel at full level, as without panning.
+    void clearPan() noexcept                    { panned = false; }
+
+    // velocity gain times carrier level, with an attack counted at its peak; used for voice stealing.
+    float getLoudness() const noexcept
+    {
+        return (float) level * (carrierEnvelope.isAttacking() ? 1.0f : carrierEnvelope.getLevel());
+    }
+
+    // longest run of samples that renderBlock processes per kernel pass; longer blocks are split.
+    static constexpr int maxKernelBlockSize = 64;
+
+private:
+    // add gain * samples[0, numSamples) to every output channel with one vector operation each; the
+    // pan gains are folded into the multiply, so a panned voice costs the same as an unpanned one.
+    void addToChannels (juce::AudioSampleBuffer& outputBuffer, int startSample, int numSamples, float gain) noexcept
+    {
+        auto numChannels = outputBuffer.getNumChannels();
+        auto isPanned = panned && numChannels >= 2;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto channelGain = (isPanned && ch < 2) ? gain * panGains[(size_t) ch] : gain;
+            juce::FloatVectorOperations::addWithMultiply (outputBuffer.getWritePointer (ch, startSample), samples.data(), channelGain, numSamples);
+        }
+    }
+
+    const DefaultSineTable& sineTable;
+    Phasor carrier, modulator;
+    ADSREnvelope carrierEnvelope, modulatorEnvelope;
+    double level = 0.0;
+    std::array<float, 2> panGains { 1.0f, 1.0f };
+    bool panned = false;
+
+    // scratch arrays for renderBlock and the mono output of renderNextBlock
+    std::array<juce::uint32, maxKernelBlockSize> carrierPhases, modulatorPhases;
+    std::array<float, maxKernelBlockSize> carrierLevels, modulatorLevels, modulation, samples;
+};
+
+#include "VoiceBank.h"
+
+//==============================================================================
+// get FM parameters of the named preset.
+inline FMParameters getFMPreset (const juce::String& name)
+{
+    FMParameters p;
+
+    //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Problem #0 ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Replace this block with your Homework #3 solution. ////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    if (name == "Brass")
+    {
+        p.carrierAmplitude      = 1.0f;
+        p.carrierAttackTime     = 0.0f;
+        p.carrierDecayTime      = 0.01f;
+        p.carrierSustainLevel   = 1.0f;
+        p.carrierReleaseTime    = 0.01f;
+        
+        p.modulatorAmplitude    = 0.0f;
+        p.modulatorFreqRatio    = 1.0f;
+        p.modulatorAttackTime   = 0.0f;
+        p.modulatorDecayTime    = 0.01f;
+        p.modulatorSustainLevel = 1.0f;
+        p.modulatorReleaseTime  = 0.01f;
+    }
+    else if (name == "Bell")
+    {
+        p.carrierAmplitude      = 1.0f;
+        p.carrierAttackTime     = 0.0f;
+        p.carrierDecayTime      = 0.01f;
+        p.carrierSustainLevel   = 1.0f;
+        p.carrierReleaseTime    = 0.01f;
+        
+        p.modulatorAmplitude    = 0.0f;
+        p.modulatorFreqRatio    = 1.0f;
+        p.modulatorAttackTime   = 0.0f;
+        p.modulatorDecayTime    = 0.01f;
+        p.modulatorSustainLevel = 1.0f;
+        p.modulatorReleaseTime  = 0.01f;
+    }
+    else if (name == "Electric Piano")
+    {
+        p.carrierAmplitude      = 1.0f;
+        p.carrierAttackTime     = 0.0f;
+        p.carrierDecayTime      = 0.01f;
+        p.carrierSustainLevel   = 1.0f;
+        p.carrierReleaseTime    = 0.01f;
+        
+        p.modulatorAmplitude    = 0.0f;
+        p.modulatorFreqRatio    = 1.0f;
+        p.modulatorAttackTime   = 0.0f;
+        p.modulatorDecayTime    = 0.01f;
+        p.modulatorSustainLevel = 1.0f;
+        p.modulatorReleaseTime  = 0.01f;
+    }
+    else if (name == "Your Sound")
+    {
+        p.carrierAmplitude      = 1.0f;
+        p.carrierAttackTime     = 0.0f;
+        p.carrierDecayTime      = 0.01f;
+        p.carrierSustainLevel   = 1.0f;
+        p.carrierReleaseTime    = 0.01f;
+        
+        p.modulatorAmplitude    = 0.0f;
+        p.modulatorFreqRatio    = 1.0f;
+        p.modulatorAttackTime   = 0.0f;
+        p.modulatorDecayTime    = 0.01f;
+        p.modulatorSustainLevel = 1.0f;
+        p.modulatorReleaseTime  = 0.01f;
+    }
+    //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    else
+    {
+        p.carrierAmplitude      = 1.0f;
+        p.carrierAttackTime     = 0.01f;
+        p.carrierDecayTime      = 0.01f;
+        p.carrierSustainLevel   = 1.0f;
+        p.carrierReleaseTime    = 0.01f;
+        
+        p.modulatorAmplitude    = 0.0f;
+        p.modulatorFreqRatio    = 1.0f;
+        p.modulatorAttackTime   = 0.0f;
+        p.modulatorDecayTime    = 0.01f;
+        p.modulatorSustainLevel = 1.0f;
+        p.modulatorReleaseTime  = 0.01f;
+    }
+
+    return p;
+}
+
+//==============================================================================
+// effect parameters, with the default values of each effect type.
+struct FXParameters
+{
+    float feedback  = 0.0f;
+    float delayTime = 0.0f;
+    float wetDry    = 0.0f;
+    float LFORate   = 0.0f;
+    float LFODepth  = 0.0f;
+};
+
+inline FXParameters getFXPreset (const juce::String& name)
+{
+    FXParameters p;
+
+    if (name == "Delay")
+    {
+        p.feedback  = 0.5f;
+        p.delayTime = 0.3f;
+        p.wetDry    = 0.5f;
+    }
+    else if (name == "Chorus")
+    {
+        p.delayTime = 0.1f;
+        p.wetDry    = 0.5f;
+        p.LFORate   = 2.0f;
+        p.LFODepth  = 0.0005f;
+    }
+    else if (name == "Flanger")
+    {
+        p.delayTime = 0.02f;
+        p.wetDry    = 0.5f;
+        p.LFORate   = 0.4f;
+        p.LFODepth  = 0.001f;
+    }
+    else if (name == "MultiTap")
+    {
+        p.wetDry    = 0.5f;
+    }
+    else if (name == "CrossFeedback")
+    {
+        p.feedback  = 0.6f;
+        p.delayTime = 0.25f;
+        p.wetDry    = 0.5f;
+    }
+
+    return p;
+}
+
+//==============================================================================
+class FMSynthesizer     : public juce::Synthesiser
+{
+public:
+    void renderVoices (juce::AudioBuffer<float>& buffer, int startSample, int numSamples) override
+    {
+        // one snapshot per block, so every voice renders the block with the same parameters
+        fmParameters.update();
+        auto& parameters = fmParameters.get();
+
+        syncVoiceAllocator();
+
+        if (voiceBank != nullptr)
+            renderVoiceBank (buffer, startSample, numSamples, parameters);
+        else
+            renderFMVoices (buffer, startSample, numSamples, parameters);
+
+        retireFinishedVoices();
+    }
+
+    // the master bus: run the effect, then the reverbs, over a whole block after renderNextBlock
+    // has rendered it. renderVoices is called once for each stretch between MIDI events, so an
+    // effect run there would be split into many short blocks under dense MIDI, each paying the
+    // effect's per-call setup; here it runs once per audio callback.
+    void processEffects (juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (numSamples <= 0)
+            return;
+
+        auto block = juce::dsp::AudioBlock<float> (buffer).getSubBlock ((size_t) startSample, (size_t) numSamples);
+        auto context = juce::dsp::ProcessContextReplacing<float> (block);
+
+        if (FX.getFXType() != EffectType::none)
+            FX.process (context);
+
+        if (reverb != nullptr)
+            reverb->process (context);
+
+        if (fdnReverb != nullptr)
+            fdnReverb->process (context);
+    }
+
+    // the largest block processEffects() will be given; sizes the delay lines and LFO buffers of
+    // the effect for the current sample rate, and sets the partition size, and so the latency,
+    // of the reverb. Call it after setCurrentPlaybackSampleRate().
+    void prepareMasterBus (int maxBlockSize)
+    {
+        const juce::ScopedLock sl (lock);
+        masterBusBlockSize = juce::jmax (1, maxBlockSize);
+        FX.prepare (getMasterBusSpec());
+
+        if (reverb != nullptr)
+            reverb->prepare (getMasterBusSpec());
+
+        if (fdnReverb != nullptr)
+            fdnReverb->prepare (getMasterBusSpec());
+    }
+
+    // put a convolution reverb with this impulse response on the master bus. The impulse response
+    // is transformed on the calling thread and the new reverb swapped in under the lock, so the
+    // audio thread never waits for the FFTs.
+    void setReverb (const juce::AudioBuffer<float>& impulseResponse, double impulseResponseSampleRate, float wetLevel)
+    {
+        auto newReverb = std::make_unique<ConvolutionReverb>();
+        newReverb->setRealtime (realtime);
+        newReverb->setImpulseResponse (impulseResponse, impulseResponseSampleRate);
+        newReverb->setWetLevel (wetLevel);
+        newReverb->prepare (getMasterBusSpec());
+
+        const juce::ScopedLock sl (lock);
+        std::swap (reverb, newReverb);
+    }
+
+    // false when rendering offline: the reverb then runs a late tail job on the rendering thread
+    // instead of waiting for its worker. Takes effect from the next setReverb().
+    void setRealtime (bool shouldBeRealtime)    {realtime = shouldBeRealtime;}
+
+    void clearReverb()
+    {
+        std::unique_ptr<ConvolutionReverb> oldReverb;
+
+        const juce::ScopedLock sl (lock);
+        std::swap (reverb, oldReverb);
+    }
+
+    // put an 8-line feedback-delay-network reverb on the master bus, after the convolution
+    // reverb if there is one; it is made and prepared on the calling thread, like setReverb().
+    void setFDNReverb (float decayTime, float wetLevel)
+    {
+        auto newReverb = std::make_unique<FDNReverb<float>>();
+        newReverb->setDecayTime (decayTime);
+        newReverb->setWetLevel (wetLevel);
+        newReverb->prepare (getMasterBusSpec());
+
+        const juce::ScopedLock sl (lock);
+        std::swap (fdnReverb, newReverb);
+    }
+
+    void clearFDNReverb()
+    {
+        std::unique_ptr<FDNReverb<float>> oldReverb;
+
+        const juce::ScopedLock sl (lock);
+        std::swap (fdnReverb, oldReverb);
+    }
+
+    // the setters publish a new parameter set for the audio thread; call them from one thread only.
+    void setCarrierAmplitude(float value)       {setFMParameter (&FMParameters::carrierAmplitude, value);}
+    void setCarrierAttackTime(float value)      {setFMParameter (&FMParameters::carrierAttackTime, value);}
+    void setCarrierDecayTime(float value)       {setFMParameter (&FMParameters::carrierDecayTime, value);}
+    void setCarrierSustainLevel(float value)    {setFMParameter (&FMParameters::carrierSustainLevel, value);}
+    void setCarrierReleaseTime(float value)     {setFMParameter (&FMParameters::carrierReleaseTime, value);}
+    
+    void setModulatorAmplitude(float value)     {setFMParameter (&FMParameters::modulatorAmplitude, value);}
+    void setModulatorFreqRatio(float value)     {setFMParameter (&FMParameters::modulatorFreqRatio, value);}
+    void setModulatorAttackTime(float value)    {setFMParameter (&FMParameters::modulatorAttackTime, value);}
+    void setModulatorDecayTime(float value)     {setFMParameter (&FMParameters::modulatorDecayTime, value);}
+    void setModulatorSustainLevel(float value)  {setFMParameter (&FMParameters::modulatorSustainLevel, value);}
+    void setModulatorReleaseTime(float value)   {setFMParameter (&FMParameters::modulatorReleaseTime, value);}
+
+    // a whole preset is published at once, so the audio thread never sees half of it.
+    void setFMParameters (const FMParameters& p)    {fmParameters.publish (p);}
+
+    // the parameters last set, as seen from the setting thread.
+    FMParameters getFMParameters() const            {return fmParameters.getPublished();}
+
+    // same as juce::Synthesiser::noteOn, but the voice comes from the allocator instead of a scan of the whole pool.
+    void noteOn (int midiChannel, int midiNoteNumber, float velocity) override
+    {
+        const juce::ScopedLock sl (lock);
+        syncVoiceAllocator();
+
+        // idle voices are not rendered, so the note gets its envelope times from here
+        fmParameters.update();
+
+        for (auto* sound : sounds)
+        {
+            if (sound->appliesToNote (midiNoteNumber) && sound->appliesToChannel (midiChannel))
+            {
+                // a note that is still ringing, e.g. held by the sustain pedal, is stopped first
+                for (auto i = voiceAllocator.getOldest(); i >= 0; i = voiceAllocator.getNext (i))
+                {
+                    auto* voice = voices.getUnchecked (i);
+
+                    if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
+                        stopVoice (voice, 1.0f, true);
+                }
+
+                auto index = allocateVoice();
+
+                if (index >= 0)
+                {
+                    if (voiceBank != nullptr)
+                    {
+                        voiceBank->setParameters (fmParameters.get());
+                    }
+                    else
+                    {
+                        auto* fmVoice = static_cast<FMVoice*> (voices.getUnchecked (index));
+                        fmVoice->setEnvelopeTimes (fmParameters.get());
+
+                        if (stereoSpread > 0.0f)
+                            fmVoice->setPan (stereoSpread * (float) (midiNoteNumber - 60) / 36.0f);
+                        else
+                            fmVoice->clearPan();
+                    }
+
+                    startVoice (voices.getUnchecked (index), sound, midiChannel, midiNoteNumber, velocity);
+                    voiceAllocator.activate (index);
+                }
+            }
+        }
+    }
+
+    // same as juce::Synthesiser::noteOff, visiting only the sounding voices.
+    void noteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override
+    {
+        const juce::ScopedLock sl (lock);
+        syncVoiceAllocator();
+
+        for (auto i = voiceAllocator.getOldest(); i >= 0; i = voiceAllocator.getNext (i))
+        {
+            auto* voice = voices.getUnchecked (i);
+
+            if (voice->isPlayingChannel (midiChannel) && voice->getCurrentlyPlayingNote() == midiNoteNumber)
+            {
+                if (auto sound = voice->getCurrentlyPlayingSound())
+                {
+                    if (sound->appliesToNote (midiNoteNumber) && sound->appliesToChannel (midiChannel))
+                    {
+                        voice->setKeyDown (false);
+
+                        if (! (voice->isSustainPedalDown() || voice->isSostenutoPedalDown()))
+                            stopVoice (voice, velocity, allowTailOff);
+                    }
+                }
+            }
+        }
+    }
+
+    // replace the voices with numVoices FMVoices. Only sounding voices are rendered, so a large
+    // pool costs no more than the notes actually playing.
+    void setPolyphony (int numVoices)
+    {
+        const juce::ScopedLock sl (lock);
+        clearVoices();
+        voiceBank.reset();
+
+        for (int i = 0; i < numVoices; ++i)
+            addVoice (new FMVoice());
+
+        resetVoiceAllocator (numVoices);
+    }
+
+    // which sounding voice a new note takes over when every voice is busy.
+    void setVoiceStealingPolicy (VoiceAllocator::StealingPolicy policy)
+    {
+        const juce::ScopedLock sl (lock);
+        voiceAllocator.setStealingPolicy (policy);
+    }
+
+    int getNumActiveVoices() const noexcept             {return voiceAllocator.getNumActive();}
+
+    // render FMVoices on numThreads threads: the audio thread and numThreads - 1 workers. The
+    // output is bit-identical for any number of threads. The voice bank always renders on one thread.
+    // Only the swap of the workers holds the lock; they are started and stopped outside it.
+    void setNumRenderThreads (int numThreads)
+    {
+        renderPool.setNumWorkers (juce::jmax (0, numThreads - 1), lock);
+    }
+
+    int getNumRenderThreads() const noexcept            {return renderPool.getNumWorkers() + 1;}
+
+    // pan FMVoice notes by key with constant power: middle C in the centre, three octaves either
+    // side fully left or right at a spread of 1. At 0 (default) voices are not panned at all.
+    // Takes effect from the next note; the voice bank is never panned.
+    void setStereoSpread (float spread)
+    {
+        const juce::ScopedLock sl (lock);
+        stereoSpread = juce::jlimit (0.0f, 1.0f, spread);
+    }
+
+    // choose between the vectorised FMVoice::renderBlock (default) and the per-sample reference path.
+    void setBlockRendering (bool shouldUseBlocks)   {blockRendering = shouldUseBlocks;}
+
+    // replace the voices with numVoices FMBankVoices, whose notes are all rendered together by one FMVoiceBank.
+    void useVoiceBank (int numVoices)
+    {
+        const juce::ScopedLock sl (lock);
+        clearVoices();
+        voiceBank = std::make_unique<FMVoiceBank> (numVoices);
+        voiceBankBuffer.resize ((size_t) 4096);
+
+        for (int i = 0; i < numVoices; ++i)
+            addVoice (new FMBankVoice (*voiceBank, i));
+
+        resetVoiceAllocator (numVoices);
+    }
+
+    // parameter changes are ramped by the effect over its next block; the delay lines are kept.
+    void setFXParameters (const FXParameters& p)
+    {
+        FX.setFeedback (p.feedback);
+        FX.setDelayTimes (p.delayTime);
+        FX.setWetDry (p.wetDry);
+        FX.setLFORate (p.LFORate);
+        FX.setLFODepth (p.LFODepth);
+    }
+
+    // the name is turned into an EffectType here, so the audio thread never compares strings.
+    void setFXType (const juce::String& value)  {setFXType (getEffectType (value));}
+    void setFXType (EffectType value)           {const juce::ScopedLock sl (lock); FX.setFXType(value);}
+    void setNumDelayTaps (size_t value)         {const juce::ScopedLock sl (lock); FX.setNumTaps(value);}
+    void setDelayTap (size_t index, const DelayTap& tap) {const juce::ScopedLock sl (lock); FX.setTap(index, tap);}
+    void setFeedbackMatrix (const CrossFeedbackDelay<float, 2>::Matrix& m) {const juce::ScopedLock sl (lock); FX.setFeedbackMatrix(m);}
+    void setFeedback (float value)      {FX.setFeedback(value);}
+    void setDelayTime (float value)     {FX.setDelayTimes(value);}
+    void setWetDry (float value)        {FX.setWetDry(value);}
+    void setLFORate (float value)       {FX.setLFORate(value);}
+    void setLFODepth (float value)      {FX.setLFODepth(value);}
+    void setSampleRate ()               {const juce::ScopedLock sl (lock); FX.setSampleRate(getSampleRate());}
+
+private:
+    void setFMParameter (float FMParameters::* member, float value)
+    {
+        auto p = fmParameters.getPublished();
+        p.*member = value;
+        fmParameters.publish (p);
+    }
+
+    // voices added with addVoice() rather than setPolyphony() are picked up here.
+    void syncVoiceAllocator()
+    {
+        if (voiceAllocator.size() == voices.size())
+            return;
+
+        resetVoiceAllocator (voices.size());
+
+        for (int i = 0; i < voices.size(); ++i)
+            if (voices.getUnchecked (i)->isVoiceActive())
+                voiceAllocator.activate (i);
+    }
+
+    // forget all notes, and size the voice groups for up to numVoices sounding voices.
+    void resetVoiceAllocator (int numVoices)
+    {
+        voiceAllocator.reset (numVoices);
+        activeVoices.clear();
+        activeVoices.reserve ((size_t) numVoices);
+        groupBuses.setSize (2 * juce::jmax (1, (numVoices + voicesPerGroup - 1) / voicesPerGroup), groupBlockSize);
+    }
+
+    // a free voice, else one to steal if stealing is enabled, else -1.
+    int allocateVoice()
+    {
+        auto index = voiceAllocator.getFreeVoice();
+
+        if (index < 0)
+        {
+            // voices stopped without tail-off since the last block may be idle already
+            retireFinishedVoices();
+            index = voiceAllocator.getFreeVoice();
+        }
+
+        if (index < 0 && isNoteStealingEnabled())
+            index = voiceAllocator.takeVoiceToSteal();
+
+        return index;
+    }
+
+    // move voices whose note has ended to the free list, and note how loud the others are.
+    void retireFinishedVoices()
+    {
+        for (auto i = voiceAllocator.getOldest(); i >= 0;)
+        {
+            auto nextIndex = voiceAllocator.getNext (i);
+            auto* voice = voices.getUnchecked (i);
+
+            if (! voice->isVoiceActive())
+                voiceAllocator.deactivate (i);
+            else if (voiceBank != nullptr)
+                voiceAllocator.setLoudness (i, voiceBank->getLoudness (i));
+            else
+                voiceAllocator.setLoudness (i, static_cast<FMVoice*> (voice)->getLoudness());
+
+            i = nextIndex;
+        }
+
+        voiceAllocator.updateStealingOrder();
+    }
+
+    // the sounding voices are split, in the order their notes started, into fixed groups of
+    // voicesPerGroup. Each group renders into its own bus, on whichever thread claims it, and
+    // the buses are summed into the output in group order. The grouping does not depend on the
+    // number of threads, so neither does a single bit of the output. Buses are mono, added to
+    // every channel, unless voices are panned into a stereo or wider output; then they are
+    // stereo, and further channels get the left or right bus by their parity.
+    void renderFMVoices (juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const FMParameters& parameters)
+    {
+        activeVoices.clear();
+
+        for (auto i = voiceAllocator.getOldest(); i >= 0; i = voiceAllocator.getNext (i))
+            activeVoices.push_back (i);
+
+        auto numGroups = ((int) activeVoices.size() + voicesPerGroup - 1) / voicesPerGroup;
+        groupParameters = &parameters;
+        groupBusChannels = (stereoSpread > 0.0f && buffer.getNumChannels() >= 2) ? 2 : 1;
+
+        while (numSamples > 0)
+        {
+            groupBlockLength = juce::jmin (numSamples, groupBlockSize);
+            renderPool.run (renderGroupJob, numGroups);
+
+            for (int group = 0; group < numGroups; ++group)
+                for (auto i = buffer.getNumChannels(); --i >= 0;)
+                    juce::FloatVectorOperations::add (buffer.getWritePointer (i, startSample),
+                                                      groupBuses.getReadPointer (2 * group + (i % groupBusChannels)),
+                                                      groupBlockLength);
+
+            startSample += groupBlockLength;
+            numSamples  -= groupBlockLength;
+        }
+    }
+
+    void renderVoiceGroup (int group)
+    {
+        float* busData[] = { groupBuses.getWritePointer (2 * group), groupBuses.getWritePointer (2 * group + 1) };
+        juce::AudioBuffer<float> bus (busData, groupBusChannels, groupBlockLength);
+        bus.clear();
+
+        auto& parameters = *groupParameters;
+        auto end = juce::jmin ((group + 1) * voicesPerGroup, (int) activeVoices.size());
+
+        for (auto k = group * voicesPerGroup; k < end; ++k){
+            FMVoice *fmsynthVoice = static_cast<FMVoice*>(voices.getUnchecked (activeVoices[(size_t) k]));
+
+            if (blockRendering)
+            {
+                fmsynthVoice->renderBlock (bus, 0, groupBlockLength, parameters);
+                continue;
+            }
+
+            fmsynthVoice->renderNextBlock(  bus, 0, groupBlockLength,
+                                            parameters.carrierAmplitude,
+                                            parameters.carrierAttackTime, parameters.carrierDecayTime,
+                                            parameters.carrierSustainLevel, parameters.carrierReleaseTime,
+                                            parameters.modulatorAmplitude, parameters.modulatorFreqRatio,
+                                            parameters.modulatorAttackTime, parameters.modulatorDecayTime,
+                                            parameters.modulatorSustainLevel, parameters.modulatorReleaseTime
+                                          );
+        }
+    }
+
+    void renderVoiceBank (juce::AudioBuffer<float>& buffer, int startSample, int numSamples, const FMParameters& parameters)
+    {
+        while (numSamples > 0)
+        {
+            auto numThisTime = juce::jmin (numSamples, (int) voiceBankBuffer.size());
+
+            std::fill (voiceBankBuffer.begin(), voiceBankBuffer.begin() + numThisTime, 0.0f);
+            voiceBank->render (voiceBankBuffer.data(), numThisTime, parameters);
+
+            for (auto i = buffer.getNumChannels(); --i >= 0;)
+                juce::FloatVectorOperations::add (buffer.getWritePointer (i, startSample), voiceBankBuffer.data(), numThisTime);
+
+            startSample += numThisTime;
+            numSamples  -= numThisTime;
+        }
+
+        for (auto i = voiceAllocator.getOldest(); i >= 0; i = voiceAllocator.getNext (i))
+            static_cast<FMBankVoice*> (voices.getUnchecked (i))->updateNoteState();
+    }
+
+    ParameterStore<FMParameters> fmParameters;
+    VoiceAllocator voiceAllocator;
+
+    static constexpr int voicesPerGroup = 8, groupBlockSize = 512;
+    std::vector<int> activeVoices;
+    juce::AudioBuffer<float> groupBuses;
+    const FMParameters* groupParameters = nullptr;
+    int groupBlockLength = 0, groupBusChannels = 1;
+    float stereoSpread = 0.0f;
+    RenderThreadPool renderPool;
+    RenderThreadPool::Job renderGroupJob { [this] (int group) { renderVoiceGroup (group); } };
+
+    bool blockRendering = true;
+    std::unique_ptr<FMVoiceBank> voiceBank;
+    std::vector<float> voiceBankBuffer;
+
+    Effect<float> FX;
+
+    // stereo, as in the app and the offline renderer
+    juce::dsp::ProcessSpec getMasterBusSpec() const    { return { getSampleRate(), (juce::uint32) masterBusBlockSize, 2 }; }
+
+    std::unique_ptr<ConvolutionReverb> reverb;
+    std::unique_ptr<FDNReverb<float>> fdnReverb;
+    int masterBusBlockSize = 512;
+    bool realtime = true;
+};
+
+
+//==============================================================================
+class SynthAudioSource   :  public juce::AudioSource
+{
+public:
+    SynthAudioSource (juce::MidiKeyboardState& keyState, int numVoices = 4)
+        : keyboardState (keyState)
+    {
+        synth.setPolyphony (numVoices);
         synth.addSound (new SineWaveSound());
     }
 
@@ -572,9 +1425,10 @@ public:
         synth.clearSounds();
     }
 
-    void prepareToPlay (int /*samplesPerBlockExpected*/, double sampleRate) override
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override
     {
         synth.setCurrentPlaybackSampleRate (sampleRate);
+        synth.prepareMasterBus (samplesPerBlockExpected);
         midiCollector.reset (sampleRate);
     }
 
@@ -592,6 +1446,17 @@ public:
 
         synth.renderNextBlock (*bufferToFill.buffer, incomingMidi,
                                bufferToFill.startSample, bufferToFill.numSamples);
+        synth.processEffects (*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+    }
+
+    // render a block from MIDI events given by the caller instead of the realtime MIDI collector.
+    // used by the offline renderer, where no audio device drives the callback.
+    void renderNextBlock ( juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages,
+                           int startSample, int numSamples )
+    {
+        buffer.clear (startSample, numSamples);
+        synth.renderNextBlock (buffer, midiMessages, startSample, numSamples);
+        synth.processEffects (buffer, startSample, numSamples);
     }
 
     juce::MidiMessageCollector* getMidiCollector()
@@ -611,6 +1476,17 @@ public:
     void setModulatorDecayTime(float value)     {synth.setModulatorDecayTime(value);}
     void setModulatorSustainLevel(float value)  {synth.setModulatorSustainLevel(value);}
     void setModulatorReleaseTime(float value)   {synth.setModulatorReleaseTime(value);}
+    void setFMParameters(const FMParameters& p) {synth.setFMParameters(p);}
+    void setPolyphony(int numVoices)            {synth.setPolyphony(numVoices);}
+    void setStereoSpread(float spread)          {synth.setStereoSpread(spread);}
+    void setNumDelayTaps(size_t value)          {synth.setNumDelayTaps(value);}
+    void setDelayTap(size_t index, const DelayTap& tap) {synth.setDelayTap(index, tap);}
+    void setFeedbackMatrix(const CrossFeedbackDelay<float, 2>::Matrix& m) {synth.setFeedbackMatrix(m);}
+    void setReverb(const juce::AudioBuffer<float>& ir, double irSampleRate, float wetLevel) {synth.setReverb(ir, irSampleRate, wetLevel);}
+    void clearReverb()                          {synth.clearReverb();}
+    void setFDNReverb(float decayTime, float wetLevel) {synth.setFDNReverb(decayTime, wetLevel);}
+    void clearFDNReverb()                       {synth.clearFDNReverb();}
+    void setRealtime(bool shouldBeRealtime)     {synth.setRealtime(shouldBeRealtime);}
 
     void setFXType (juce::String value) {synth.setFXType(value);}
     void setFeedback (float value)      {synth.setFeedback(value);}
@@ -618,6 +1494,7 @@ public:
     void setWetDry (float value)        {synth.setWetDry(value);}
     void setLFORate (float value)       {synth.setLFORate(value);}
     void setLFODepth (float value)      {synth.setLFODepth(value);}
+    void setFXParameters (const FXParameters& p) {synth.setFXParameters(p);}
     void setSampleRate ()               {synth.setSampleRate();}
 
 private:
@@ -626,568 +1503,3 @@ private:
     juce::MidiMessageCollector midiCollector;
 };
 
-
-//==============================================================================
-class MainContentComponent   : public juce::AudioAppComponent,
-                               private juce::Timer
-{
-public:
-    void loadPreset(juce::String name)
-    {
-        float presetCarrierAmplitude;
-        float presetCarrierAttackTime, presetCarrierDecayTime;
-        float presetCarrierSustainLevel, presetCarrierReleaseTime;
-        float presetModulatorAmplitude, presetModulatorFreqRatio;
-        float presetModulatorAttackTime, presetModulatorDecayTime;
-        float presetModulatorSustainLevel, presetModulatorReleaseTime;
-
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        // Problem #0 ////////////////////////////////////////////////////////////////////////////////////////////////
-        // Replace this block with your Homework #3 solution. ////////////////////////////////////////////////////////
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        if (name == "Brass")
-        {
-            presetCarrierAmplitude      = 1.0f;
-            presetCarrierAttackTime     = 0.0f;
-            presetCarrierDecayTime      = 0.01f;
-            presetCarrierSustainLevel   = 1.0f;
-            presetCarrierReleaseTime    = 0.01f;
-            
-            presetModulatorAmplitude    = 0.0f;
-            presetModulatorFreqRatio    = 1.0f;
-            presetModulatorAttackTime   = 0.0f;
-            presetModulatorDecayTime    = 0.01f;
-            presetModulatorSustainLevel = 1.0f;
-            presetModulatorReleaseTime  = 0.01f;
-        }
-        else if (name == "Bell")
-        {
-            presetCarrierAmplitude      = 1.0f;
-            presetCarrierAttackTime     = 0.0f;
-            presetCarrierDecayTime      = 0.01f;
-            presetCarrierSustainLevel   = 1.0f;
-            presetCarrierReleaseTime    = 0.01f;
-            
-            presetModulatorAmplitude    = 0.0f;
-            presetModulatorFreqRatio    = 1.0f;
-            presetModulatorAttackTime   = 0.0f;
-            presetModulatorDecayTime    = 0.01f;
-            presetModulatorSustainLevel = 1.0f;
-            presetModulatorReleaseTime  = 0.01f;
-        }
-        else if (name == "Electric Piano")
-        {
-            presetCarrierAmplitude      = 1.0f;
-            presetCarrierAttackTime     = 0.0f;
-            presetCarrierDecayTime      = 0.01f;
-            presetCarrierSustainLevel   = 1.0f;
-            presetCarrierReleaseTime    = 0.01f;
-            
-            presetModulatorAmplitude    = 0.0f;
-            presetModulatorFreqRatio    = 1.0f;
-            presetModulatorAttackTime   = 0.0f;
-            presetModulatorDecayTime    = 0.01f;
-            presetModulatorSustainLevel = 1.0f;
-            presetModulatorReleaseTime  = 0.01f;
-        }
-        else if (name == "Your Sound")
-        {
-            presetCarrierAmplitude      = 1.0f;
-            presetCarrierAttackTime     = 0.0f;
-            presetCarrierDecayTime      = 0.01f;
-            presetCarrierSustainLevel   = 1.0f;
-            presetCarrierReleaseTime    = 0.01f;
-            
-            presetModulatorAmplitude    = 0.0f;
-            presetModulatorFreqRatio    = 1.0f;
-            presetModulatorAttackTime   = 0.0f;
-            presetModulatorDecayTime    = 0.01f;
-            presetModulatorSustainLevel = 1.0f;
-            presetModulatorReleaseTime  = 0.01f;
-        }
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-        //////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-        else
-        {
-            presetCarrierAmplitude      = 1.0f;
-            presetCarrierAttackTime     = 0.01f;
-            presetCarrierDecayTime      = 0.01f;
-            presetCarrierSustainLevel   = 1.0f;
-            presetCarrierReleaseTime    = 0.01f;
-            
-            presetModulatorAmplitude    = 0.0f;
-            presetModulatorFreqRatio    = 1.0f;
-            presetModulatorAttackTime   = 0.0f;
-            presetModulatorDecayTime    = 0.01f;
-            presetModulatorSustainLevel = 1.0f;
-            presetModulatorReleaseTime  = 0.01f;
-        }
-        
-        setFMParameters(  presetCarrierAmplitude,
-                        presetCarrierAttackTime, presetCarrierDecayTime,
-                        presetCarrierSustainLevel, presetCarrierReleaseTime,
-                        presetModulatorAmplitude, presetModulatorFreqRatio,
-                        presetModulatorAttackTime, presetModulatorDecayTime,
-                        presetModulatorSustainLevel, presetModulatorReleaseTime );
-    }
-
-    void setFMParameters(
-                            float carrierAmplitude,
-                            float carrierAttackTime, float carrierDecayTime,
-                            float carrierSustainLevel, float carrierReleaseTime,
-                            float modulatorAmplitude, float modulatorFreqRatio,
-                            float modulatorAttackTime, float modulatorDecayTime,
-                            float modulatorSustainLevel, float modulatorReleaseTime
-    )
-    {
-        carrierAmplitudeSlider.setValue (carrierAmplitude, juce::dontSendNotification);
-        carrierAttackTimeSlider.setValue (carrierAttackTime, juce::dontSendNotification);
-        carrierDecayTimeSlider.setValue (carrierDecayTime, juce::dontSendNotification);
-        carrierSustainLevelSlider.setValue (carrierSustainLevel, juce::dontSendNotification);
-        carrierReleaseTimeSlider.setValue (carrierReleaseTime, juce::dontSendNotification);
-        synthAudioSource.setCarrierAmplitude(carrierAmplitudeSlider.getValue());
-        synthAudioSource.setCarrierAttackTime(carrierAttackTimeSlider.getValue());
-        synthAudioSource.setCarrierDecayTime(carrierDecayTimeSlider.getValue());
-        synthAudioSource.setCarrierSustainLevel(carrierSustainLevelSlider.getValue());
-        synthAudioSource.setCarrierReleaseTime(carrierReleaseTimeSlider.getValue());
-        
-        modulatorAmplitudeSlider.setValue (modulatorAmplitude, juce::dontSendNotification);
-        modulatorFreqRatioSlider.setValue (modulatorFreqRatio, juce::dontSendNotification);
-        modulatorAttackTimeSlider.setValue (modulatorAttackTime, juce::dontSendNotification);
-        modulatorDecayTimeSlider.setValue (modulatorDecayTime, juce::dontSendNotification);
-        modulatorSustainLevelSlider.setValue (modulatorSustainLevel, juce::dontSendNotification);
-        modulatorReleaseTimeSlider.setValue (modulatorReleaseTime, juce::dontSendNotification);
-        synthAudioSource.setModulatorAmplitude(modulatorAmplitudeSlider.getValue());
-        synthAudioSource.setModulatorFreqRatio(modulatorFreqRatioSlider.getValue());
-        synthAudioSource.setModulatorAttackTime(modulatorAttackTimeSlider.getValue());
-        synthAudioSource.setModulatorDecayTime(modulatorDecayTimeSlider.getValue());
-        synthAudioSource.setModulatorSustainLevel(modulatorSustainLevelSlider.getValue());
-        synthAudioSource.setModulatorReleaseTime(modulatorReleaseTimeSlider.getValue());
-    }
-
-    void loadFX(juce::String name)
-    {
-        float feedback, delaytime, wetdry, lforate, lfodepth;
-        if (name == "Delay")
-        {
-            feedbackSlider.setEnabled(true);
-            delayTimeSlider.setEnabled(true);
-            wetDrySlider.setEnabled(true);
-            LFORateSlider.setEnabled(false);
-            LFODepthSlider.setEnabled(false);
-            feedback = 0.5f;
-            delaytime = 0.3f;
-            wetdry = 0.5f;
-            lforate = 0.0f;
-            lfodepth = 0.0f;
-        }
-        else if (name == "Chorus")
-        {
-            feedbackSlider.setEnabled(false);
-            delayTimeSlider.setEnabled(true);
-            wetDrySlider.setEnabled(true);
-            LFORateSlider.setEnabled(true);
-            LFODepthSlider.setEnabled(true);
-            feedback = 0.0f;
-            delaytime = 0.1f;
-            wetdry = 0.5f;
-            lforate = 2.0f;
-            lfodepth = 0.0005f;
-        }
-        else if (name == "Flanger")
-        {
-            feedbackSlider.setEnabled(false);
-            delayTimeSlider.setEnabled(true);
-            wetDrySlider.setEnabled(true);
-            LFORateSlider.setEnabled(true);
-            LFODepthSlider.setEnabled(true);
-            feedback = 0.0f;
-            delaytime = 0.02f;
-            wetdry = 0.5f;
-            lforate = 0.4f;
-            lfodepth = 0.001f;
-        }
-        else
-        {
-            feedbackSlider.setEnabled(false);
-            delayTimeSlider.setEnabled(false);
-            wetDrySlider.setEnabled(false);
-            LFORateSlider.setEnabled(false);
-            LFODepthSlider.setEnabled(false);
-            feedback = 0.0f;
-            delaytime = 0.0f;
-            wetdry = 0.0f;
-            lforate = 0.0f;
-            lfodepth = 0.0f;
-        }
-        synthAudioSource.setFXType(name);
-        synthAudioSource.setFeedback(feedback);
-        synthAudioSource.setDelayTime(delaytime);
-        synthAudioSource.setWetDry(wetdry);
-        synthAudioSource.setLFORate(lforate);
-        synthAudioSource.setLFODepth(lfodepth);
-
-        feedbackSlider.setValue (feedback, juce::dontSendNotification); 
-        delayTimeSlider.setValue (delaytime, juce::dontSendNotification); 
-        wetDrySlider.setValue (wetdry, juce::dontSendNotification); 
-        LFORateSlider.setValue (lforate, juce::dontSendNotification); 
-        LFODepthSlider.setValue (lfodepth, juce::dontSendNotification); 
-    }
-
-    MainContentComponent()
-        : synthAudioSource  (keyboardState),
-          keyboardComponent (keyboardState, juce::MidiKeyboardComponent::horizontalKeyboard)
-    {
-        synthAudioSource.setSampleRate();
-
-        addAndMakeVisible (carrierAmplitudeSlider);
-        carrierAmplitudeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        carrierAmplitudeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        carrierAmplitudeSlider.setRange (0, 5, 0.1);
-        carrierAmplitudeSlider.setValue (1, juce::dontSendNotification);
-        carrierAmplitudeSlider.onValueChange = [this] { synthAudioSource.setCarrierAmplitude(carrierAmplitudeSlider.getValue()); };
-
-        addAndMakeVisible (carrierAttackTimeSlider);
-        carrierAttackTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        carrierAttackTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        carrierAttackTimeSlider.setRange (0, 5, 0.01);
-        carrierAttackTimeSlider.setValue (0, juce::dontSendNotification);
-        carrierAttackTimeSlider.onValueChange = [this] { synthAudioSource.setCarrierAttackTime(carrierAttackTimeSlider.getValue()); };
-
-        addAndMakeVisible (carrierDecayTimeSlider);
-        carrierDecayTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        carrierDecayTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        carrierDecayTimeSlider.setRange (0.01, 5, 0.01);
-        carrierDecayTimeSlider.setValue (0, juce::dontSendNotification);
-        carrierDecayTimeSlider.onValueChange = [this] { synthAudioSource.setCarrierDecayTime(carrierDecayTimeSlider.getValue()); };
-
-        addAndMakeVisible (carrierSustainLevelSlider);
-        carrierSustainLevelSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        carrierSustainLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        carrierSustainLevelSlider.setRange (0.01, 1, 0.01);
-        carrierSustainLevelSlider.setValue (1, juce::dontSendNotification);
-        carrierSustainLevelSlider.onValueChange = [this] { synthAudioSource.setCarrierSustainLevel(carrierSustainLevelSlider.getValue()); };
-
-        addAndMakeVisible (carrierReleaseTimeSlider);
-        carrierReleaseTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        carrierReleaseTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        carrierReleaseTimeSlider.setRange (0.01, 5, 0.01);
-        carrierReleaseTimeSlider.setValue (0, juce::dontSendNotification);
-        carrierReleaseTimeSlider.onValueChange = [this] { synthAudioSource.setCarrierReleaseTime(carrierReleaseTimeSlider.getValue()); };
-
-        modulatorAmplitudeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        modulatorAmplitudeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        modulatorAmplitudeSlider.setRange (0, 5, 0.1);
-        modulatorAmplitudeSlider.setValue (0, juce::dontSendNotification);
-        modulatorAmplitudeSlider.onValueChange = [this] { synthAudioSource.setModulatorAmplitude(modulatorAmplitudeSlider.getValue()); };
-        addAndMakeVisible (modulatorAmplitudeSlider);
-
-        modulatorFreqRatioSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        modulatorFreqRatioSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        modulatorFreqRatioSlider.setRange (0.1, 10, 0.1);
-        modulatorFreqRatioSlider.setValue (1, juce::dontSendNotification);
-        modulatorFreqRatioSlider.onValueChange = [this] { synthAudioSource.setModulatorFreqRatio(modulatorFreqRatioSlider.getValue()); };
-        addAndMakeVisible (modulatorFreqRatioSlider);
-
-        addAndMakeVisible (modulatorAttackTimeSlider);
-        modulatorAttackTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        modulatorAttackTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        modulatorAttackTimeSlider.setRange (0, 5, 0.01);
-        modulatorAttackTimeSlider.setValue (0, juce::dontSendNotification);
-        modulatorAttackTimeSlider.onValueChange = [this] { synthAudioSource.setModulatorAttackTime(modulatorAttackTimeSlider.getValue()); };
-
-        addAndMakeVisible (modulatorDecayTimeSlider);
-        modulatorDecayTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        modulatorDecayTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        modulatorDecayTimeSlider.setRange (0.01, 5, 0.01);
-        modulatorDecayTimeSlider.setValue (0.01, juce::dontSendNotification);
-        modulatorDecayTimeSlider.onValueChange = [this] { synthAudioSource.setModulatorDecayTime(modulatorDecayTimeSlider.getValue()); };
-
-        addAndMakeVisible (modulatorSustainLevelSlider);
-        modulatorSustainLevelSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        modulatorSustainLevelSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        modulatorSustainLevelSlider.setRange (0.01, 1, 0.01);
-        modulatorSustainLevelSlider.setValue (1, juce::dontSendNotification);
-        modulatorSustainLevelSlider.onValueChange = [this] { synthAudioSource.setModulatorSustainLevel(modulatorSustainLevelSlider.getValue()); };
-
-        addAndMakeVisible (modulatorReleaseTimeSlider);
-        modulatorReleaseTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        modulatorReleaseTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        modulatorReleaseTimeSlider.setRange (0.01, 5, 0.01);
-        modulatorReleaseTimeSlider.setValue (0.01, juce::dontSendNotification);
-        modulatorReleaseTimeSlider.onValueChange = [this] { synthAudioSource.setModulatorReleaseTime(modulatorReleaseTimeSlider.getValue()); };
-
-        addAndMakeVisible (feedbackSlider);
-        feedbackSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        feedbackSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        feedbackSlider.setRange (0.0, 1.0, 0.01);
-        feedbackSlider.setValue (0.0, juce::dontSendNotification);
-        feedbackSlider.onValueChange = [this] { synthAudioSource.setFeedback(feedbackSlider.getValue()); };
-        feedbackSlider.setEnabled(false);
-
-        addAndMakeVisible (delayTimeSlider);
-        delayTimeSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        delayTimeSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        delayTimeSlider.setRange (0.0, 1.0, 0.001);
-        delayTimeSlider.setValue (0.0, juce::dontSendNotification);
-        delayTimeSlider.onValueChange = [this] { synthAudioSource.setDelayTime(delayTimeSlider.getValue()); };
-        delayTimeSlider.setEnabled(false);
-
-        addAndMakeVisible (wetDrySlider);
-        wetDrySlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        wetDrySlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        wetDrySlider.setRange (0.0, 1.0, 0.01);
-        wetDrySlider.setValue (0.0, juce::dontSendNotification);
-        wetDrySlider.onValueChange = [this] { synthAudioSource.setWetDry(wetDrySlider.getValue()); };
-        wetDrySlider.setEnabled(false);
-
-        addAndMakeVisible (LFORateSlider);
-        LFORateSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        LFORateSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        LFORateSlider.setRange (0.0, 10.0, 0.01);
-        LFORateSlider.setValue (0.0, juce::dontSendNotification);
-        LFORateSlider.onValueChange = [this] { synthAudioSource.setLFORate(LFORateSlider.getValue()); };
-        addAndMakeVisible (LFODepthSlider);
-        LFODepthSlider.setSliderStyle(juce::Slider::SliderStyle::Rotary);
-        LFODepthSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 60, 20);
-        LFODepthSlider.setRange (0.0, 0.002, 0.00001);
-        LFODepthSlider.setValue (0.0, juce::dontSendNotification);
-        LFODepthSlider.onValueChange = [this] { synthAudioSource.setLFODepth(LFODepthSlider.getValue()); };
-        LFODepthSlider.setEnabled(false);
-
-        addAndMakeVisible (keyboardComponent);
-
-        titleLabel                  .setText("GCT535 FM Synthesizer", juce::dontSendNotification);
-        carrierLabel                .setText("Carrier Parameters", juce::dontSendNotification);
-        carrierAmplitudeLabel       .setText("Amplitude", juce::dontSendNotification);
-        carrierAttackTimeLabel      .setText("Attack [s]", juce::dontSendNotification);
-        carrierDecayTimeLabel       .setText("Decay [s]", juce::dontSendNotification);
-        carrierSustainLevelLabel    .setText("Sustain", juce::dontSendNotification);
-        carrierReleaseTimeLabel     .setText("Release [s]", juce::dontSendNotification);
-        modulatorLabel              .setText("Modulator Parameters", juce::dontSendNotification);
-        modulatorAmplitudeLabel     .setText("Amplitude", juce::dontSendNotification);
-        modulatorFreqRatioLabel     .setText("Freq. Ratio", juce::dontSendNotification);
-        modulatorAttackTimeLabel    .setText("Attack [s]", juce::dontSendNotification);
-        modulatorDecayTimeLabel     .setText("Decay [s]", juce::dontSendNotification);
-        modulatorSustainLevelLabel  .setText("Sustain", juce::dontSendNotification);
-        modulatorReleaseTimeLabel   .setText("Release [s]", juce::dontSendNotification);
-        presetListLabel             .setText("Presets", juce::dontSendNotification);
-        fxLabel                     .setText("FX Parameters", juce::dontSendNotification);
-        fxListLabel                 .setText("FX", juce::dontSendNotification);
-        feedbackLabel               .setText("Feedback", juce::dontSendNotification);
-        delayTimeLabel              .setText("Delay Time [s]", juce::dontSendNotification);
-        wetDryLabel                 .setText("Wet/Dry", juce::dontSendNotification);
-        LFORateLabel                .setText("LFO Rate [Hz]", juce::dontSendNotification);
-        LFODepthLabel               .setText("LFO Depth", juce::dontSendNotification);
-
-        titleLabel                  .setJustificationType(juce::Justification::centredLeft);
-        carrierLabel                .setJustificationType(juce::Justification::centred);
-        carrierAmplitudeLabel       .setJustificationType(juce::Justification::centred);
-        carrierAttackTimeLabel      .setJustificationType(juce::Justification::centred);
-        carrierDecayTimeLabel       .setJustificationType(juce::Justification::centred);
-        carrierSustainLevelLabel    .setJustificationType(juce::Justification::centred);
-        carrierReleaseTimeLabel     .setJustificationType(juce::Justification::centred);
-        modulatorLabel              .setJustificationType(juce::Justification::centred);
-        modulatorAmplitudeLabel     .setJustificationType(juce::Justification::centred);
-        modulatorFreqRatioLabel     .setJustificationType(juce::Justification::centred);
-        modulatorAttackTimeLabel    .setJustificationType(juce::Justification::centred);
-        modulatorDecayTimeLabel     .setJustificationType(juce::Justification::centred);
-        modulatorSustainLevelLabel  .setJustificationType(juce::Justification::centred);
-        modulatorReleaseTimeLabel   .setJustificationType(juce::Justification::centred);
-        presetListLabel             .setJustificationType(juce::Justification::centred);
-        fxLabel                     .setJustificationType(juce::Justification::centred);
-        fxListLabel                 .setJustificationType(juce::Justification::centredRight);
-        feedbackLabel               .setJustificationType(juce::Justification::centred);
-        delayTimeLabel              .setJustificationType(juce::Justification::centred);
-        wetDryLabel                 .setJustificationType(juce::Justification::centred);
-        LFORateLabel                .setJustificationType(juce::Justification::centred);
-        LFODepthLabel               .setJustificationType(juce::Justification::centred);
-
-        addAndMakeVisible (titleLabel);
-        addAndMakeVisible (carrierLabel);
-        addAndMakeVisible (carrierAmplitudeLabel);
-        addAndMakeVisible (carrierAttackTimeLabel);
-        addAndMakeVisible (carrierDecayTimeLabel);
-        addAndMakeVisible (carrierSustainLevelLabel);
-        addAndMakeVisible (carrierReleaseTimeLabel);
-        addAndMakeVisible (modulatorLabel);
-        addAndMakeVisible (modulatorAmplitudeLabel);
-        addAndMakeVisible (modulatorFreqRatioLabel);
-        addAndMakeVisible (modulatorAttackTimeLabel);
-        addAndMakeVisible (modulatorDecayTimeLabel);
-        addAndMakeVisible (modulatorSustainLevelLabel);
-        addAndMakeVisible (modulatorReleaseTimeLabel);
-        addAndMakeVisible (presetListLabel);
-        addAndMakeVisible (fxListLabel);
-
-        addAndMakeVisible (fxLabel);
-        addAndMakeVisible (feedbackLabel);
-        addAndMakeVisible (delayTimeLabel);
-        addAndMakeVisible (wetDryLabel);
-        addAndMakeVisible (LFORateLabel);
-        addAndMakeVisible (LFODepthLabel);
-        
-        addAndMakeVisible (presetList);
-        juce::StringArray presetNames;
-        presetNames.add("Default");
-        presetNames.add("Bell");
-        presetNames.add("Brass");
-        presetNames.add("Electric Piano");
-        presetNames.add("Your Sound");
-        presetList.addItemList( presetNames, 1 );
-        presetList.setSelectedItemIndex(0);
-        presetList.onChange = [this] { loadPreset (presetList.getItemText(presetList.getSelectedItemIndex())); };
-        
-        addAndMakeVisible (fxList);
-        juce::StringArray fxNames;
-        fxNames.add("None");
-        fxNames.add("Delay");
-        fxNames.add("Chorus");
-        fxNames.add("Flanger");
-        fxList.addItemList( fxNames, 1 );
-        fxList.setSelectedItemIndex(0);
-        fxList.onChange = [this] { loadFX (fxList.getItemText(fxList.getSelectedItemIndex())); synthAudioSource.setSampleRate(); };
-
-        setAudioChannels (0, 2);
-        setSize(820, 430);
-        startTimer (400);
-    }
-
-    ~MainContentComponent() override
-    {
-        shutdownAudio();
-    }
-
-    void resized() override
-    {
-        int borderLeft  = 10; 
-        int borderTop   = 10;
-        int dialWidth   = 70;
-        int dialHeight  = 70;
-        int labelHeight = 40;
-
-        carrierLabel                .setBounds (0, borderTop, 410, 20);
-        modulatorLabel              .setBounds (410, borderTop, 410, 20);
-        carrierAmplitudeLabel       .setBounds (borderLeft   + dialWidth*0,  borderTop+25, 70, 20);
-        carrierAttackTimeLabel      .setBounds (borderLeft   + dialWidth*1,  borderTop+25, 70, 20);
-        carrierDecayTimeLabel       .setBounds (borderLeft   + dialWidth*2,  borderTop+25, 70, 20);
-        carrierSustainLevelLabel    .setBounds (borderLeft   + dialWidth*3,  borderTop+25, 70, 20);
-        carrierReleaseTimeLabel     .setBounds (borderLeft   + dialWidth*4,  borderTop+25, 70, 20);
-        modulatorAmplitudeLabel     .setBounds (borderLeft*4 + dialWidth*5,  borderTop+25, 70, 20);
-        modulatorFreqRatioLabel     .setBounds (borderLeft*4 + dialWidth*6,  borderTop+25, 70, 20);
-        modulatorAttackTimeLabel    .setBounds (borderLeft*4 + dialWidth*7,  borderTop+25, 70, 20);
-        modulatorDecayTimeLabel     .setBounds (borderLeft*4 + dialWidth*8,  borderTop+25, 70, 20);
-        modulatorSustainLevelLabel  .setBounds (borderLeft*4 + dialWidth*9,  borderTop+25, 70, 20);
-        modulatorReleaseTimeLabel   .setBounds (borderLeft*4 + dialWidth*10, borderTop+25, 70, 20);
-
-        fxLabel             .setBounds (0, borderTop+labelHeight+dialHeight+10, 410, 20);
-        fxListLabel         .setBounds (410, borderTop+labelHeight+dialHeight+10, 100,  20);
-        fxList              .setBounds (515, borderTop+labelHeight+dialHeight+10, 140, 20);
-        feedbackLabel       .setBounds (borderLeft+dialWidth*1, borderTop+labelHeight+dialHeight+35, 140, 20);
-        delayTimeLabel      .setBounds (borderLeft+dialWidth*3, borderTop+labelHeight+dialHeight+35, 140, 20);
-        wetDryLabel         .setBounds (borderLeft+dialWidth*5, borderTop+labelHeight+dialHeight+35, 140, 20);
-        LFORateLabel        .setBounds (borderLeft+dialWidth*7, borderTop+labelHeight+dialHeight+35, 140, 20);
-        LFODepthLabel       .setBounds (borderLeft+dialWidth*9, borderTop+labelHeight+dialHeight+35, 140, 20);
-
-        carrierAmplitudeSlider      .setBounds (borderLeft   + dialWidth*0,  borderTop+labelHeight, dialWidth, dialHeight);
-        carrierAttackTimeSlider     .setBounds (borderLeft   + dialWidth*1,  borderTop+labelHeight, dialWidth, dialHeight);
-        carrierDecayTimeSlider      .setBounds (borderLeft   + dialWidth*2,  borderTop+labelHeight, dialWidth, dialHeight);
-        carrierSustainLevelSlider   .setBounds (borderLeft   + dialWidth*3,  borderTop+labelHeight, dialWidth, dialHeight);
-        carrierReleaseTimeSlider    .setBounds (borderLeft   + dialWidth*4,  borderTop+labelHeight, dialWidth, dialHeight);
-        modulatorAmplitudeSlider    .setBounds (borderLeft*4 + dialWidth*5,  borderTop+labelHeight, dialWidth, dialHeight);
-        modulatorFreqRatioSlider    .setBounds (borderLeft*4 + dialWidth*6,  borderTop+labelHeight, dialWidth, dialHeight);
-        modulatorAttackTimeSlider   .setBounds (borderLeft*4 + dialWidth*7,  borderTop+labelHeight, dialWidth, dialHeight);
-        modulatorDecayTimeSlider    .setBounds (borderLeft*4 + dialWidth*8,  borderTop+labelHeight, dialWidth, dialHeight);
-        modulatorSustainLevelSlider .setBounds (borderLeft*4 + dialWidth*9,  borderTop+labelHeight, dialWidth, dialHeight);
-        modulatorReleaseTimeSlider  .setBounds (borderLeft*4 + dialWidth*10, borderTop+labelHeight, dialWidth, dialHeight);
-        
-        feedbackSlider              .setBounds (borderLeft+dialWidth*1+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
-        delayTimeSlider             .setBounds (borderLeft+dialWidth*3+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
-        wetDrySlider                .setBounds (borderLeft+dialWidth*5+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
-        LFORateSlider               .setBounds (borderLeft+dialWidth*7+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
-        LFODepthSlider              .setBounds (borderLeft+dialWidth*9+35, borderTop+labelHeight+dialHeight+50, dialWidth, dialHeight);
-
-        keyboardComponent           .setBounds (borderLeft, 250, 800, 150);
-
-        titleLabel                  .setBounds ( 30,  405, 300, 20);
-        presetListLabel             .setBounds ( 595, 405, 80,  20);
-        presetList                  .setBounds ( 665, 405, 120, 20);
-    }
-
-    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override
-    {
-        synthAudioSource.prepareToPlay (samplesPerBlockExpected, sampleRate);
-        synthAudioSource.setSampleRate();
-    }
-
-    void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override
-    {
-        synthAudioSource.getNextAudioBlock (bufferToFill);
-    }
-
-    void releaseResources() override
-    {
-        synthAudioSource.releaseResources();
-    }
-
-private:
-    void timerCallback() override
-    {
-        keyboardComponent.grabKeyboardFocus();
-        stopTimer();
-    }
-
-    juce::Label titleLabel;
-    juce::Label carrierLabel;
-    juce::Label modulatorLabel;
-
-    juce::Label carrierAmplitudeLabel;
-    juce::Label carrierAttackTimeLabel;
-    juce::Label carrierDecayTimeLabel;
-    juce::Label carrierSustainLevelLabel;
-    juce::Label carrierReleaseTimeLabel;
-    juce::Slider carrierAmplitudeSlider;
-    juce::Slider carrierAttackTimeSlider;
-    juce::Slider carrierDecayTimeSlider;
-    juce::Slider carrierSustainLevelSlider;
-    juce::Slider carrierReleaseTimeSlider;
-
-    juce::Label modulatorAmplitudeLabel;
-    juce::Label modulatorFreqRatioLabel;
-    juce::Label modulatorAttackTimeLabel;
-    juce::Label modulatorDecayTimeLabel;
-    juce::Label modulatorSustainLevelLabel;
-    juce::Label modulatorReleaseTimeLabel;
-    juce::Slider modulatorAmplitudeSlider;
-    juce::Slider modulatorFreqRatioSlider;
-    juce::Slider modulatorAttackTimeSlider;
-    juce::Slider modulatorDecayTimeSlider;
-    juce::Slider modulatorSustainLevelSlider;
-    juce::Slider modulatorReleaseTimeSlider;
-
-    juce::MidiKeyboardState keyboardState;
-    SynthAudioSource synthAudioSource;
-    juce::MidiKeyboardComponent keyboardComponent;
-
-    juce::Label presetListLabel;
-    juce::ComboBox presetList;
-
-    juce::Label fxLabel;
-    juce::Label feedbackLabel;
-    juce::Label delayTimeLabel;
-    juce::Label wetDryLabel;
-    juce::Label LFORateLabel;
-    juce::Label LFODepthLabel;
-    juce::Slider feedbackSlider;
-    juce::Slider delayTimeSlider;
-    juce::Slider wetDrySlider;
-    juce::Slider LFORateSlider;
-    juce::Slider LFODepthSlider;
-
-    juce::Label fxListLabel;
-    juce::ComboBox fxList;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainContentComponent)
-};
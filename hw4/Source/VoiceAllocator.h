@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    VoiceAllocator.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// Bookkeeping of which voices of a synth are sounding, by voice index. Sounding voices
+// are kept in an intrusive doubly linked list in the order their notes started and idle
+// voices on a free stack, so finding a free voice, starting a note and retiring a finished
+// one are O(1), and a render pass can walk only the sounding voices however large the pool.
+// When every voice is busy, the oldest voice is the head of the list; for the quietest,
+// a heap ordered by the loudness each voice reported after the last block is used.
+class VoiceAllocator
+{
+public:
+    enum class StealingPolicy { oldest, quietest };
+
+    // forget all notes; every voice becomes free.
+    void reset (int numVoices)
+    {
+        previous.assign ((size_t) numVoices, -1);
+        next.assign ((size_t) numVoices, -1);
+        active.assign ((size_t) numVoices, false);
+        loudness.assign ((size_t) numVoices, 0.0f);
+        startBlock.assign ((size_t) numVoices, 0);
+        stealingOrder.clear();
+        stealingOrder.reserve ((size_t) numVoices);
+        freeVoices.clear();
+
+        for (int i = numVoices; --i >= 0;)
+            freeVoices.push_back (i);
+
+        oldest = newest = -1;
+        numActive = 0;
+    }
+
+    int size() const noexcept                               { return (int) active.size(); }
+    int getNumActive() const noexcept                       { return numActive; }
+    bool isActive (int voice) const noexcept                { return active[(size_t) voice]; }
+
+    // walk the sounding voices from the oldest note: for (v = getOldest(); v >= 0; v = getNext (v))
+    int getOldest() const noexcept                          { return oldest; }
+    int getNext (int voice) const noexcept                  { return next[(size_t) voice]; }
+
+    // an idle voice, or -1 if every voice is sounding.
+    int getFreeVoice() const noexcept                       { return freeVoices.empty() ? -1 : freeVoices.back(); }
+
+    // mark the voice as playing the newest note; a voice that was already sounding moves to the end.
+    void activate (int voice)
+    {
+        if (active[(size_t) voice])
+        {
+            unlink (voice);
+        }
+        else
+        {
+            // always the top of the stack, unless the allocator is being rebuilt from existing voices
+            auto found = std::find (freeVoices.rbegin(), freeVoices.rend(), voice);
+            jassert (found != freeVoices.rend());
+            freeVoices.erase (std::next (found).base());
+
+            active[(size_t) voice] = true;
+            ++numActive;
+        }
+
+        previous[(size_t) voice] = newest;
+        next[(size_t) voice] = -1;
+
+        if (newest >= 0)
+            next[(size_t) newest] = voice;
+        else
+            oldest = voice;
+
+        newest = voice;
+        startBlock[(size_t) voice] = blockNumber;
+    }
+
+    // the voice has finished its note.
+    void deactivate (int voice)
+    {
+        if (! active[(size_t) voice])
+            return;
+
+        unlink (voice);
+        active[(size_t) voice] = false;
+        --numActive;
+        freeVoices.push_back (voice);
+    }
+
+    void setStealingPolicy (StealingPolicy newPolicy) noexcept     { policy = newPolicy; }
+    StealingPolicy getStealingPolicy() const noexcept               { return policy; }
+
+    void setLoudness (int voice, float newLoudness) noexcept        { loudness[(size_t) voice] = newLoudness; }
+
+    // rebuild the quietest-first order from the loudness values; call once per block after they are set.
+    void updateStealingOrder()
+    {
+        stealingOrder.clear();
+        ++blockNumber;
+
+        if (policy != StealingPolicy::quietest)
+            return;
+
+        for (auto voice = oldest; voice >= 0; voice = next[(size_t) voice])
+            stealingOrder.push_back (voice);
+
+        std::make_heap (stealingOrder.begin(), stealingOrder.end(), [this] (int a, int b) { return isLouder (a, b); });
+    }
+
+    // the sounding voice to give the next note to when none is free, or -1 if nothing is sounding.
+    // Under the quietest policy notes started since the order was built are left alone; once
+    // the order runs out, the oldest voice is taken.
+    int takeVoiceToSteal()
+    {
+        while (! stealingOrder.empty())
+        {
+            std::pop_heap (stealingOrder.begin(), stealingOrder.end(), [this] (int a, int b) { return isLouder (a, b); });
+            auto voice = stealingOrder.back();
+            stealingOrder.pop_back();
+
+            if (active[(size_t) voice] && startBlock[(size_t) voice] != blockNumber)
+                return voice;
+        }
+
+        return oldest;
+    }
+
+private:
+    // heap order that puts the quietest voice on top.
+    bool isLouder (int a, int b) const noexcept
+    {
+        return loudness[(size_t) a] > loudness[(size_t) b];
+    }
+
+    void unlink (int voice) noexcept
+    {
+        auto p = previous[(size_t) voice], n = next[(size_t) voice];
+
+        if (p >= 0) next[(size_t) p] = n;       else oldest = n;
+        if (n >= 0) previous[(size_t) n] = p;   else newest = p;
+    }
+
+    std::vector<int> previous, next, freeVoices, stealingOrder;
+    std::vector<bool> active;
+    std::vector<float> loudness;
+    std::vector<juce::uint32> startBlock;
+    juce::uint32 blockNumber = 0;
+    StealingPolicy policy = StealingPolicy::oldest;
+    int oldest = -1, newest = -1, numActive = 0;
+};
@@ -0,0 +1,350 @@
+/*
+  ==============================================================================
+
+    VoiceBank.h
+    Created: October, 2026
+    Author:  Minsuk Choi and Jaekwon Im 
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Oscillator.h"
+#include "Envelope.h"
+
+//==============================================================================
+// State of every FM voice kept in structure-of-arrays form. Sounding voices are packed
+// into the lowest lanes, padded to whole groups of lanesPerGroup, and each sample is one
+// vector loop across the lanes, so dense polyphony costs about one SIMD lane per voice
+// rather than one full voice render per note. Voices are addressed by a stable slot
+// number; the lane a slot lives in changes as other voices finish and lanes are compacted.
+// Envelopes step through the same ADSREnvelope segments as FMVoice, one lane per voice.
+class FMVoiceBank
+{
+public:
+    static constexpr int lanesPerGroup = 8;
+
+    explicit FMVoiceBank (int maxNumVoices)
+    {
+        auto numLanes = (size_t) (((maxNumVoices + lanesPerGroup - 1) / lanesPerGroup) * lanesPerGroup);
+
+        carrierPhase.resize (numLanes);
+        carrierIncrement.resize (numLanes);
+        modulatorPhase.resize (numLanes);
+        modulatorIncrement.resize (numLanes);
+        gain.resize (numLanes);
+        valueScratch.resize (numLanes);
+        laneToSlot.resize (numLanes);
+        slotToLane.assign ((size_t) maxNumVoices, -1);
+
+        for (auto* envelope : { &carrierEnvelope, &modulatorEnvelope })
+        {
+            envelope->level.resize (numLanes);
+            envelope->multiplier.resize (numLanes);
+            envelope->offset.resize (numLanes);
+            envelope->target.resize (numLanes);
+            envelope->stage.resize (numLanes);
+            envelope->samplesLeft.resize (numLanes);
+        }
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            clearLane ((int) lane);
+    }
+
+    int getNumActiveVoices() const noexcept                 { return numActive; }
+    bool isPlaying (int slot) const noexcept                { return slotToLane[(size_t) slot] >= 0; }
+
+    // gain times carrier level of the slot, with an attack counted at its peak; used for voice stealing.
+    float getLoudness (int slot) const noexcept
+    {
+        auto lane = (size_t) slotToLane[(size_t) slot];
+
+        if (slotToLane[(size_t) slot] < 0)
+            return 0.0f;
+
+        return gain[lane] * (carrierEnvelope.stage[lane] == attack ? 1.0f : carrierEnvelope.level[lane]);
+    }
+
+    // start a note in the given slot, restarting it if the slot is still sounding.
+    void startNote (int slot, double frequency, double newSampleRate, float velocityGain)
+    {
+        sampleRate = newSampleRate;
+
+        auto lane = slotToLane[(size_t) slot];
+
+        if (lane < 0)
+        {
+            lane = numActive++;
+            slotToLane[(size_t) slot] = lane;
+            laneToSlot[(size_t) lane] = slot;
+        }
+
+        Phasor phasor;
+        phasor.setFrequency (frequency, sampleRate);
+
+        carrierPhase[(size_t) lane]       = 0;
+        modulatorPhase[(size_t) lane]     = 0;
+        carrierIncrement[(size_t) lane]   = phasor.increment;
+        modulatorIncrement[(size_t) lane] = (juce::uint32) (juce::uint64) (phasor.increment * (double) parameters.modulatorFreqRatio);
+        gain[(size_t) lane]               = velocityGain;
+
+        carrierEnvelope.level[(size_t) lane]   = 0.0f;
+        modulatorEnvelope.level[(size_t) lane] = 0.0f;
+        enterStage (carrierEnvelope, lane, attack, parameters.getCarrierTimes());
+        enterStage (modulatorEnvelope, lane, attack, parameters.getModulatorTimes());
+    }
+
+    void stopNote (int slot, bool allowTailOff)
+    {
+        auto lane = slotToLane[(size_t) slot];
+
+        if (lane < 0)
+            return;
+
+        if (! allowTailOff)
+        {
+            removeLane (lane);
+            return;
+        }
+
+        if (carrierEnvelope.stage[(size_t) lane] != release)
+            enterStage (carrierEnvelope, lane, release, parameters.getCarrierTimes());
+
+        if (modulatorEnvelope.stage[(size_t) lane] != release)
+            enterStage (modulatorEnvelope, lane, release, parameters.getModulatorTimes());
+    }
+
+    // the parameters notes started from now on take their envelope times from.
+    void setParameters (const FMParameters& p)              { parameters = p; }
+
+    // add numSamples of the sum of all sounding voices to output.
+    void render (float* output, int numSamples, const FMParameters& p)
+    {
+        parameters = p;
+
+        for (int lane = 0; lane < numActive; ++lane)
+            modulatorIncrement[(size_t) lane] = (juce::uint32) (juce::uint64) (carrierIncrement[(size_t) lane] * (double) p.modulatorFreqRatio);
+
+        auto position = 0;
+
+        while (position < numSamples && numActive > 0)
+        {
+            // split at the next envelope stage change of any voice, so each chunk is one segment per lane
+            auto numThisTime = juce::jmin (numSamples - position, maxChunkSize);
+
+            for (int lane = 0; lane < numActive; ++lane)
+                numThisTime = juce::jmin (numThisTime, carrierEnvelope.samplesLeft[(size_t) lane],
+                                          modulatorEnvelope.samplesLeft[(size_t) lane]);
+
+            renderLanes (output + position, numThisTime);
+            advanceStages (numThisTime);
+            position += numThisTime;
+        }
+    }
+
+private:
+    enum Stage { attack = ADSREnvelope::attack, decay, sustain, release, idle };
+
+    struct EnvelopeLanes
+    {
+        std::vector<float> level, multiplier, offset, target;
+        std::vector<int> stage, samplesLeft;
+    };
+
+    void enterStage (EnvelopeLanes& envelope, int lane, int stage, const ADSRTimes& times)
+    {
+        auto l = (size_t) lane;
+        auto segment = ADSREnvelope::makeSegment (stage, envelope.level[l], times, sampleRate);
+
+        envelope.stage[l]       = stage;
+        envelope.multiplier[l]  = segment.multiplier;
+        envelope.offset[l]      = segment.offset;
+        envelope.target[l]      = segment.target;
+        envelope.samplesLeft[l] = segment.numSamples;
+    }
+
+    void advanceStages (int numSamples)
+    {
+        for (int lane = 0; lane < numActive; ++lane)
+        {
+            carrierEnvelope.samplesLeft[(size_t) lane]   -= numSamples;
+            modulatorEnvelope.samplesLeft[(size_t) lane] -= numSamples;
+        }
+
+        // backwards, as removing a lane moves the last active lane into its place
+        for (int lane = numActive; --lane >= 0;)
+        {
+            for (auto* envelope : { &modulatorEnvelope, &carrierEnvelope })
+            {
+                if (envelope->samplesLeft[(size_t) lane] == 0)
+                {
+                    auto stage = envelope->stage[(size_t) lane];
+                    envelope->level[(size_t) lane] = envelope->target[(size_t) lane];
+                    enterStage (*envelope, lane, stage == sustain ? sustain : stage + 1,
+                                envelope == &carrierEnvelope ? parameters.getCarrierTimes() : parameters.getModulatorTimes());
+                }
+            }
+
+            if (carrierEnvelope.stage[(size_t) lane] == idle)
+                removeLane (lane);
+        }
+    }
+
+    // render one sample of every lane per pass of a single vector loop across the lanes.
+    void renderLanes (float* output, int numSamples) noexcept
+    {
+        auto numLanes = ((numActive + lanesPerGroup - 1) / lanesPerGroup) * lanesPerGroup;
+        auto* values = valueScratch.data();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            renderLaneSample (values, numLanes, carrierPhase.data(), carrierIncrement.data(),
+                              modulatorPhase.data(), modulatorIncrement.data(),
+                              carrierEnvelope.level.data(), carrierEnvelope.multiplier.data(), carrierEnvelope.offset.data(),
+                              modulatorEnvelope.level.data(), modulatorEnvelope.multiplier.data(), modulatorEnvelope.offset.data(),
+                              gain.data(), parameters.carrierAmplitude, parameters.modulatorAmplitude);
+
+            // sum lane groups elementwise, then the lanes of the last group, so the order is fixed
+            std::array<float, lanesPerGroup> sum {};
+
+            for (int g = 0; g < numLanes; g += lanesPerGroup)
+                for (int l = 0; l < lanesPerGroup; ++l)
+                    sum[(size_t) l] += values[g + l];
+
+            output[i] += std::accumulate (sum.begin(), sum.end(), 0.0f);
+        }
+    }
+
+    // the FM pair of each lane for one sample. The lane arrays never overlap; saying so with __restrict
+    // lets the compiler vectorise the loop without a run-time overlap check for each pair of arrays.
+    static void renderLaneSample (float* __restrict values, int numLanes,
+                                  juce::uint32* __restrict carP, const juce::uint32* __restrict carInc,
+                                  juce::uint32* __restrict modP, const juce::uint32* __restrict modInc,
+                                  float* __restrict carLevel, const float* __restrict carMul, const float* __restrict carOff,
+                                  float* __restrict modLevel, const float* __restrict modMul, const float* __restrict modOff,
+                                  const float* __restrict laneGain, float carrierAmplitude, float modulatorAmplitude) noexcept
+    {
+        for (int l = 0; l < numLanes; ++l)
+        {
+            auto modulation = sineOfPhase (modP[l]) * modLevel[l] * modulatorAmplitude;
+            values[l] = sineOfPhase (carP[l] + phaseOffsetOf (modulation)) * carLevel[l] * laneGain[l] * carrierAmplitude;
+
+            carP[l]     += carInc[l];
+            modP[l]     += modInc[l];
+            carLevel[l] = carLevel[l] * carMul[l] + carOff[l];
+            modLevel[l] = modLevel[l] * modMul[l] + modOff[l];
+        }
+    }
+
+    // move the last active lane into this one, so the sounding voices stay packed.
+    void removeLane (int lane)
+    {
+        auto last = numActive - 1;
+        slotToLane[(size_t) laneToSlot[(size_t) lane]] = -1;
+
+        if (lane != last)
+        {
+            copyLane (last, lane);
+            laneToSlot[(size_t) lane] = laneToSlot[(size_t) last];
+            slotToLane[(size_t) laneToSlot[(size_t) lane]] = lane;
+        }
+
+        clearLane (last);
+        numActive = last;
+    }
+
+    void copyLane (int from, int to)
+    {
+        auto f = (size_t) from, t = (size_t) to;
+        carrierPhase[t]       = carrierPhase[f];
+        carrierIncrement[t]   = carrierIncrement[f];
+        modulatorPhase[t]     = modulatorPhase[f];
+        modulatorIncrement[t] = modulatorIncrement[f];
+        gain[t]               = gain[f];
+
+        for (auto* envelope : { &carrierEnvelope, &modulatorEnvelope })
+        {
+            envelope->level[t]       = envelope->level[f];
+            envelope->multiplier[t]  = envelope->multiplier[f];
+            envelope->offset[t]      = envelope->offset[f];
+            envelope->target[t]      = envelope->target[f];
+            envelope->stage[t]       = envelope->stage[f];
+            envelope->samplesLeft[t] = envelope->samplesLeft[f];
+        }
+    }
+
+    // a cleared lane renders silence, so partly filled lane groups need no special case.
+    void clearLane (int lane)
+    {
+        auto l = (size_t) lane;
+        carrierPhase[l] = carrierIncrement[l] = modulatorPhase[l] = modulatorIncrement[l] = 0;
+        gain[l] = 0.0f;
+        laneToSlot[l] = -1;
+
+        for (auto* envelope : { &carrierEnvelope, &modulatorEnvelope })
+        {
+            envelope->level[l]       = 0.0f;
+            envelope->multiplier[l]  = 1.0f;
+            envelope->offset[l]      = 0.0f;
+            envelope->target[l]      = 0.0f;
+            envelope->stage[l]       = idle;
+            envelope->samplesLeft[l] = std::numeric_limits<int>::max();
+        }
+    }
+
+    static constexpr int maxChunkSize = 64;
+
+    std::vector<juce::uint32> carrierPhase, carrierIncrement, modulatorPhase, modulatorIncrement;
+    std::vector<float> gain;
+    EnvelopeLanes carrierEnvelope, modulatorEnvelope;
+    std::vector<int> laneToSlot, slotToLane;
+    std::vector<float> valueScratch;
+
+    FMParameters parameters;
+    double sampleRate = 48000.0;
+    int numActive = 0;
+};
+
+//==============================================================================
+// Voice that only tells an FMVoiceBank which notes to play; FMSynthesizer renders the
+// whole bank at once, so renderNextBlock does nothing here.
+struct FMBankVoice   : public juce::SynthesiserVoice
+{
+    FMBankVoice (FMVoiceBank& bankToUse, int slotToUse) : bank (bankToUse), slot (slotToUse) {}
+
+    bool canPlaySound (juce::SynthesiserSound* sound) override
+    {
+        return dynamic_cast<SineWaveSound*> (sound) != nullptr;
+    }
+
+    void startNote (int midiNoteNumber, float velocity,
+                    juce::SynthesiserSound*, int /*currentPitchWheelPosition*/) override
+    {
+        bank.startNote (slot, juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber), getSampleRate(), velocity * 0.15f);
+    }
+
+    void stopNote (float /*velocity*/, bool allowTailOff) override
+    {
+        bank.stopNote (slot, allowTailOff);
+
+        if (! allowTailOff)
+            clearCurrentNote();
+    }
+
+    void pitchWheelMoved (int) override      {}
+    void controllerMoved (int, int) override {}
+
+    void renderNextBlock (juce::AudioSampleBuffer&, int, int) override {}
+
+    // release the voice for new notes once its release has finished in the bank.
+    void updateNoteState()
+    {
+        if (isVoiceActive() && ! bank.isPlaying (slot))
+            clearCurrentNote();
+    }
+
+private:
+    FMVoiceBank& bank;
+    int slot;
+};